@@ -1,53 +1,18 @@
 #-------------------------------------------------
 #
-# Project created by QtCreator 2020-02-07T09:39:46
+# Minesweeper: headless game engine library, the Qt Widgets
+# game, a command-line game simulator and engine benchmarks
 #
 #-------------------------------------------------
 
-QT       += core gui
+TEMPLATE = subdirs
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+SUBDIRS += \
+    core \
+    app \
+    simulator \
+    bench
 
-TARGET = Minesweeper
-TEMPLATE = app
-QMAKE_LFLAGS += -no-pie
-
-# The following define makes your compiler emit warnings if you use
-# any feature of Qt which has been marked as deprecated (the exact warnings
-# depend on your compiler). Please consult the documentation of the
-# deprecated API in order to know how to port your code away from it.
-DEFINES += QT_DEPRECATED_WARNINGS
-
-# You can also make your code fail to compile if you use deprecated APIs.
-# In order to do so, uncomment the following line.
-# You can also select to disable deprecated APIs only up to a certain version of Qt.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-CONFIG += c++11
-
-SOURCES += \
-    GameSignals.cpp \
-        main.cpp \
-        MainWindow.cpp \
-    Cell.cpp \
-    Board.cpp \
-    BoardWidget.cpp \
-    GameManager.cpp \
-    BoardSizeDialog.cpp
-
-HEADERS += \
-    GameSignals.h \
-        MainWindow.h \
-    Cell.h \
-    Board.h \
-    BoardWidget.h \
-    GameManager.h \
-    BoardSizeDialog.h
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
-
-RESOURCES += \
-    resources.qrc
+app.depends = core
+simulator.depends = core
+bench.depends = core
@@ -0,0 +1,60 @@
+#include "AnimationClock.h"
+#include <QTimerEvent>
+
+namespace {
+
+// Tick interval in milliseconds. All animation delays are multiples of this.
+const int TickInterval = 20;
+
+}
+
+AnimationClock::AnimationClock(QObject *parent) : QObject(parent)
+{
+    m_clock.start();
+}
+
+// Current animation time in milliseconds
+qint64 AnimationClock::now() const
+{
+    return m_clock.elapsed();
+}
+
+// Start advancing a cell's animation
+void AnimationClock::start(int index)
+{
+    m_active.insert(index);
+    if (!m_timer.isActive()) {
+        m_timer.start(TickInterval, Qt::PreciseTimer, this);
+    }
+}
+
+// Stop advancing a cell's animation
+void AnimationClock::stop(int index)
+{
+    m_active.remove(index);
+    if (m_active.isEmpty()) {
+        m_timer.stop();
+    }
+}
+
+// Stop all animations, e.g. when starting a new game
+void AnimationClock::stopAll()
+{
+    m_active.clear();
+    m_timer.stop();
+}
+
+// Cells currently animating
+const QSet<int> &AnimationClock::activeCells() const
+{
+    return m_active;
+}
+
+void AnimationClock::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_timer.timerId()) {
+        QObject::timerEvent(event);
+        return;
+    }
+    emit tick(now());
+}
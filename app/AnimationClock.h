@@ -0,0 +1,38 @@
+#ifndef ANIMATIONCLOCK_H
+#define ANIMATIONCLOCK_H
+
+#include <QObject>
+#include <QBasicTimer>
+#include <QElapsedTimer>
+#include <QSet>
+
+// Single timer that drives every cell animation on the board
+//
+// Cells that are animating are registered by index. While any are
+// registered the clock ticks at a fixed interval, and each tick reports
+// the current animation time so that all frames advance together.
+
+class AnimationClock : public QObject
+{
+    Q_OBJECT
+public:
+    explicit AnimationClock(QObject *parent = nullptr);
+    qint64 now() const;
+    void start(int index);
+    void stop(int index);
+    void stopAll();
+    const QSet<int> &activeCells() const;
+
+signals:
+    void tick(qint64 now);
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
+private:
+    QBasicTimer m_timer;
+    QElapsedTimer m_clock;
+    QSet<int> m_active;
+};
+
+#endif // ANIMATIONCLOCK_H
@@ -1,4 +1,6 @@
 #include "BoardSizeDialog.h"
+#include "NoGuessGenerator.h"
+#include <QLabel>
 #include <QLayout>
 #include <QFormLayout>
 #include <QPushButton>
@@ -15,9 +17,9 @@ BoardSizeDialog::BoardSizeDialog(int &rows, int &cols, int &mines, QWidget *pare
     m_rowsSpinBox = new QSpinBox;
     m_colsSpinBox = new QSpinBox;
     m_minesSpinBox = new QSpinBox;
-    m_rowsSpinBox->setRange(4, 60);
+    m_rowsSpinBox->setRange(4, 500);
     m_rowsSpinBox->setValue(rows);
-    m_colsSpinBox->setRange(4, 40);
+    m_colsSpinBox->setRange(4, 500);
     m_colsSpinBox->setValue(cols);
     m_minesSpinBox->setRange(1, 99);
     m_minesSpinBox->setValue(mines);
@@ -25,6 +27,10 @@ BoardSizeDialog::BoardSizeDialog(int &rows, int &cols, int &mines, QWidget *pare
     formLayout->addRow(tr("Columns"), m_colsSpinBox);
     formLayout->addRow(tr("% Mines"), m_minesSpinBox);
     mainLayout->addLayout(formLayout);
+    auto noGuessLabel = new QLabel(tr("No Guessing boards can have at most %1% mines.")
+                                   .arg(NoGuessGenerator::MaxMinePercent));
+    noGuessLabel->setWordWrap(true);
+    mainLayout->addWidget(noGuessLabel);
 
     auto okButton = new QPushButton(tr("OK"));
     connect(okButton, &QPushButton::clicked, this, &BoardSizeDialog::ok);
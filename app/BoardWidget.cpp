@@ -0,0 +1,766 @@
+#include "BoardWidget.h"
+#include "GameSignals.h"
+#include "GlyphCache.h"
+#include <QGuiApplication>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QRegion>
+#include <QScreen>
+#include <QScrollBar>
+#include <QtConcurrent>
+#include <QDebug>
+
+namespace {
+
+// Board geometry, in pixels
+const int Margin = 9;
+const int Spacing = 2;
+const int DefaultCellSize = 45;
+
+// Cell sizes the board can be zoomed to, smallest first
+const int ZoomLevels[] = { 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 45, 64 };
+const int NumZoomLevels = sizeof(ZoomLevels) / sizeof(ZoomLevels[0]);
+
+// Smaller cells are drawn without gaps between them
+const int MinSpacedCellSize = 8;
+
+// Tiles are about this many pixels across, whatever the zoom
+const int TilePixels = 256;
+
+// Memory for tile images, in kilobytes, beyond the tiles in view
+const int TileCacheKB = 64 * 1024;
+
+// Above this many changed cells, repaint their bounding rectangle
+const int MaxDirtyRects = 32;
+
+// Gap between cells of a given size
+int spacingFor(int cellSize)
+{
+    return cellSize >= MinSpacedCellSize ? Spacing : 0;
+}
+
+// Bold counts sized to the cells
+QFont cellFont(QFont font, int cellSize)
+{
+    font.setBold(true);
+    font.setPixelSize(qMax(1, cellSize * 3 / 10));
+    return font;
+}
+
+// Everything a worker needs to draw one tile
+struct TileJob
+{
+    int key;
+    int layout;
+    int version;
+    int cellSize;
+    int pitch;
+    int rows;
+    int cols;
+    qreal devicePixelRatio;
+    QColor background;
+    QFont font;
+    // The tile's cells, a row at a time
+    QVector<Cell> cells;
+};
+
+// Draw a tile's cells into an image
+QImage drawTile(const TileJob &job)
+{
+    int size = qMax(job.rows, job.cols) * job.pitch;
+    QImage image(QSize(size, size) * job.devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(job.devicePixelRatio);
+    image.fill(job.background);
+
+    QPainter painter(&image);
+    painter.setFont(job.font);
+    for (int row = 0; row < job.rows; row++) {
+        for (int col = 0; col < job.cols; col++) {
+            QRect rect(col * job.pitch, row * job.pitch, job.cellSize, job.cellSize);
+            job.cells[row * job.cols + col].paint(painter, rect, false);
+        }
+    }
+    return image;
+}
+
+}
+
+BoardWidget::BoardWidget(QWidget *parent) : QAbstractScrollArea(parent)
+{
+    m_layout = 0;
+    m_numRows = 0;
+    m_numCols = 0;
+    m_cellSize = DefaultCellSize;
+    m_tileCells = 1;
+    m_tileCols = 0;
+    m_hoverCell = -1;
+    m_gameOver = false;
+
+    setFrameShape(QFrame::NoFrame);
+    viewport()->setBackgroundRole(QPalette::Window);
+
+    // One clock drives every cell animation
+    m_animationClock = new AnimationClock(this);
+    connect(m_animationClock, &AnimationClock::tick, this, &BoardWidget::advanceAnimations);
+
+    // Tile images arrive from the workers through the event loop. The
+    // sprite and glyph caches must exist before they use them.
+    connect(this, &BoardWidget::tileRendered, this, &BoardWidget::showTile, Qt::QueuedConnection);
+    SpriteAtlas::getInstance();
+    GlyphCache::getInstance();
+
+    // Track mouse movement to highlight the cell under the cursor
+    viewport()->setMouseTracking(true);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+    // Connect to Game Signals
+    auto gameSignals = GameSignals::getInstance();
+    connect(gameSignals, &GameSignals::startGame, this, &BoardWidget::startGame);
+    connect(gameSignals, &GameSignals::replayStarted, this, &BoardWidget::startGame);
+    connect(gameSignals, &GameSignals::gameResumed, this, &BoardWidget::startGame);
+    connect(gameSignals, &GameSignals::setCellFlagged, this, &BoardWidget::flagCell);
+    connect(gameSignals, &GameSignals::cellsCleared, this, &BoardWidget::clearCells);
+    connect(gameSignals, &GameSignals::explode, this, &BoardWidget::explode);
+    connect(gameSignals, &GameSignals::minesPlaced, this, &BoardWidget::setMines);
+    connect(gameSignals, &GameSignals::markIncorrectlyFlaggedCell, this, &BoardWidget::misflagCell);
+    connect(gameSignals, &GameSignals::gameWon, this, &BoardWidget::gameWon);
+    connect(gameSignals, &GameSignals::gameLost, this, &BoardWidget::gameLost);
+    connect(gameSignals, &GameSignals::showHints, this, &BoardWidget::showHints);
+}
+
+// Wait for tiles still being drawn, since the workers report back here
+BoardWidget::~BoardWidget()
+{
+    m_renderPool.clear();
+    m_renderPool.waitForDone();
+}
+
+// Start game and reset all cells
+void BoardWidget::startGame(int rows, int cols, int mines)
+{
+    Q_UNUSED(mines)
+
+    // Stop animations from the previous game
+    m_animationClock->stopAll();
+
+    // Remember board dimensions
+    m_numRows = rows;
+    m_numCols = cols;
+
+    // Add new cells
+    m_cells.clear();
+    m_cells.fill(Cell(), m_numRows * m_numCols);
+    m_hoverCell = -1;
+    m_gameOver = false;
+
+    // Start at full size, or small enough for the board to fit the screen
+    QSize screen = QGuiApplication::primaryScreen()->availableSize() * 3 / 5;
+    m_cellSize = 0;
+    setCellSize(fitCellSize(screen), QPoint());
+    updateGeometry();
+}
+
+// Room for the whole board at the current zoom
+QSize BoardWidget::sizeHint() const
+{
+    int frame = 2 * frameWidth();
+    return boardSize() + QSize(frame, frame);
+}
+
+// Zoom in one level, keeping the centre of the view in place
+void BoardWidget::zoomIn()
+{
+    for (int level = 0; level < NumZoomLevels; level++) {
+        if (ZoomLevels[level] > m_cellSize) {
+            setCellSize(ZoomLevels[level], viewport()->rect().center());
+            return;
+        }
+    }
+}
+
+// Zoom out one level, keeping the centre of the view in place
+void BoardWidget::zoomOut()
+{
+    for (int level = NumZoomLevels - 1; level >= 0; level--) {
+        if (ZoomLevels[level] < m_cellSize) {
+            setCellSize(ZoomLevels[level], viewport()->rect().center());
+            return;
+        }
+    }
+}
+
+// Zoom so that the whole board fits in the view
+void BoardWidget::zoomToFit()
+{
+    setCellSize(fitCellSize(viewport()->size()), viewport()->rect().center());
+}
+
+// Gap between cells at the current zoom
+int BoardWidget::spacing() const
+{
+    return spacingFor(m_cellSize);
+}
+
+// Distance from one cell to the next
+int BoardWidget::pitch() const
+{
+    return m_cellSize + spacing();
+}
+
+// Size of the board with its margin, at the current zoom
+QSize BoardWidget::boardSize() const
+{
+    int width = m_numCols * pitch() - spacing() + 2 * Margin;
+    int height = m_numRows * pitch() - spacing() + 2 * Margin;
+    return QSize(qMax(width, 0), qMax(height, 0));
+}
+
+// Top left of the board in the viewport. A board smaller than the
+// viewport is centred in it; a larger one scrolls.
+QPoint BoardWidget::boardOrigin() const
+{
+    QSize board = boardSize();
+    QSize view = viewport()->size();
+    int x = board.width() < view.width() ? (view.width() - board.width()) / 2
+                                          : -horizontalScrollBar()->value();
+    int y = board.height() < view.height() ? (view.height() - board.height()) / 2
+                                            : -verticalScrollBar()->value();
+    return QPoint(x, y);
+}
+
+// Rectangle covered by a cell, in the viewport
+QRect BoardWidget::cellRect(int row, int col) const
+{
+    QPoint origin = boardOrigin();
+    return QRect(origin.x() + Margin + col * pitch(), origin.y() + Margin + row * pitch(),
+                 m_cellSize, m_cellSize);
+}
+
+// Index of the cell under a point in the viewport, or -1 if there is none
+int BoardWidget::cellIndexAt(const QPoint &pos) const
+{
+    if (m_cells.isEmpty()) {
+        return -1;
+    }
+
+    QPoint origin = boardOrigin();
+    int x = pos.x() - origin.x() - Margin;
+    int y = pos.y() - origin.y() - Margin;
+    if (x < 0 || y < 0) {
+        return -1;
+    }
+    int col = x / pitch();
+    int row = y / pitch();
+    if (row >= m_numRows || col >= m_numCols) {
+        return -1;
+    }
+    // Ignore the gaps between cells
+    if (x % pitch() >= m_cellSize || y % pitch() >= m_cellSize) {
+        return -1;
+    }
+    return row * m_numCols + col;
+}
+
+// Largest zoom level, up to full size, at which the board fits an area
+int BoardWidget::fitCellSize(const QSize &area) const
+{
+    int cellSize = ZoomLevels[0];
+    for (int level = 0; level < NumZoomLevels && ZoomLevels[level] <= DefaultCellSize; level++) {
+        int size = ZoomLevels[level];
+        int width = m_numCols * (size + spacingFor(size)) - spacingFor(size) + 2 * Margin;
+        int height = m_numRows * (size + spacingFor(size)) - spacingFor(size) + 2 * Margin;
+        if (width <= area.width() && height <= area.height()) {
+            cellSize = size;
+        }
+    }
+    return cellSize;
+}
+
+// Change the zoom level, keeping the part of the board under the anchor
+// point where it is
+void BoardWidget::setCellSize(int cellSize, const QPoint &anchor)
+{
+    cellSize = qBound(ZoomLevels[0], cellSize, ZoomLevels[NumZoomLevels - 1]);
+    if (cellSize == m_cellSize) {
+        return;
+    }
+
+    // Position under the anchor, in cells; a new board starts at the top left
+    bool keepAnchor = m_cellSize > 0;
+    double anchorCol = 0;
+    double anchorRow = 0;
+    if (keepAnchor) {
+        QPoint origin = boardOrigin();
+        anchorCol = double(anchor.x() - origin.x() - Margin) / pitch();
+        anchorRow = double(anchor.y() - origin.y() - Margin) / pitch();
+    }
+
+    m_cellSize = cellSize;
+    m_tileCells = qMax(1, TilePixels / pitch());
+    m_tileCols = (m_numCols + m_tileCells - 1) / m_tileCells;
+    resetTiles();
+    updateScrollBars();
+    if (keepAnchor) {
+        horizontalScrollBar()->setValue(qRound(Margin + anchorCol * pitch() - anchor.x()));
+        verticalScrollBar()->setValue(qRound(Margin + anchorRow * pitch() - anchor.y()));
+    } else {
+        horizontalScrollBar()->setValue(0);
+        verticalScrollBar()->setValue(0);
+    }
+    viewport()->update();
+}
+
+// Let the scroll bars cover the part of the board outside the viewport
+void BoardWidget::updateScrollBars()
+{
+    QSize board = boardSize();
+    QSize view = viewport()->size();
+    horizontalScrollBar()->setRange(0, qMax(0, board.width() - view.width()));
+    horizontalScrollBar()->setPageStep(view.width());
+    horizontalScrollBar()->setSingleStep(pitch());
+    verticalScrollBar()->setRange(0, qMax(0, board.height() - view.height()));
+    verticalScrollBar()->setPageStep(view.height());
+    verticalScrollBar()->setSingleStep(pitch());
+}
+
+void BoardWidget::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+}
+
+void BoardWidget::scrollContentsBy(int dx, int dy)
+{
+    Q_UNUSED(dx)
+    Q_UNUSED(dy)
+    viewport()->update();
+}
+
+// Tile holding a cell
+int BoardWidget::tileIndex(int cellIndex) const
+{
+    int row = cellIndex / m_numCols;
+    int col = cellIndex % m_numCols;
+    return (row / m_tileCells) * m_tileCols + col / m_tileCells;
+}
+
+// Rectangle covered by a tile, in the viewport
+QRect BoardWidget::tileRect(int tileRow, int tileCol) const
+{
+    int size = m_tileCells * pitch();
+    QPoint origin = boardOrigin();
+    return QRect(origin.x() + Margin + tileCol * size, origin.y() + Margin + tileRow * size,
+                 size, size);
+}
+
+// Range of tiles that intersect an area of the viewport, as a rectangle
+// of tile columns and rows
+QRect BoardWidget::tileRange(const QRect &area) const
+{
+    QPoint origin = boardOrigin() + QPoint(Margin, Margin);
+    int tileSize = m_tileCells * pitch();
+    int numTileRows = (m_numRows + m_tileCells - 1) / m_tileCells;
+    int firstTileCol = qBound(0, (area.left() - origin.x()) / tileSize, m_tileCols - 1);
+    int lastTileCol = qBound(0, (area.right() - origin.x()) / tileSize, m_tileCols - 1);
+    int firstTileRow = qBound(0, (area.top() - origin.y()) / tileSize, numTileRows - 1);
+    int lastTileRow = qBound(0, (area.bottom() - origin.y()) / tileSize, numTileRows - 1);
+    return QRect(QPoint(firstTileCol, firstTileRow), QPoint(lastTileCol, lastTileRow));
+}
+
+// Have a worker draw a tile from a copy of its cells
+void BoardWidget::renderTile(int tileRow, int tileCol, Tile &tile)
+{
+    TileJob job;
+    job.key = tileRow * m_tileCols + tileCol;
+    job.layout = m_layout;
+    job.version = tile.version;
+    job.cellSize = m_cellSize;
+    job.pitch = pitch();
+    job.devicePixelRatio = devicePixelRatioF();
+    job.background = palette().color(QPalette::Window);
+    job.font = cellFont(font(), m_cellSize);
+
+    int firstRow = tileRow * m_tileCells;
+    int firstCol = tileCol * m_tileCells;
+    job.rows = qMin(m_tileCells, m_numRows - firstRow);
+    job.cols = qMin(m_tileCells, m_numCols - firstCol);
+    job.cells.reserve(job.rows * job.cols);
+    for (int row = firstRow; row < firstRow + job.rows; row++) {
+        for (int col = firstCol; col < firstCol + job.cols; col++) {
+            job.cells.append(m_cells[row * m_numCols + col]);
+        }
+    }
+
+    tile.rendering = true;
+    QtConcurrent::run(&m_renderPool, [this, job]() {
+        emit tileRendered(job.key, job.layout, job.version, drawTile(job));
+    });
+}
+
+// Show a tile's new image, unless the tiles have been laid out again
+// since it was asked for. A tile that changed meanwhile is drawn again
+// when it is next painted.
+void BoardWidget::showTile(int key, int layout, int version, const QImage &image)
+{
+    if (layout != m_layout) {
+        return;
+    }
+    auto it = m_tiles.find(key);
+    if (it == m_tiles.end()) {
+        return;
+    }
+    Tile &tile = it.value();
+    tile.rendering = false;
+    tile.image = image;
+    tile.imageVersion = version;
+    viewport()->update(tileRect(key / m_tileCols, key % m_tileCols));
+}
+
+// Draw the tiles in view that intersect the area being repainted, and
+// the highlighted cell over them. Tiles that are out of date are sent to
+// the workers, and shown as they were until they come back.
+void BoardWidget::paintEvent(QPaintEvent *event)
+{
+    if (m_cells.isEmpty()) {
+        return;
+    }
+
+    QPainter painter(viewport());
+    QRect dirty = event->rect();
+    QRect tiles = tileRange(dirty);
+    for (int tileRow = tiles.top(); tileRow <= tiles.bottom(); tileRow++) {
+        for (int tileCol = tiles.left(); tileCol <= tiles.right(); tileCol++) {
+            Tile &tile = m_tiles[tileRow * m_tileCols + tileCol];
+            if (tile.imageVersion != tile.version && !tile.rendering) {
+                renderTile(tileRow, tileCol, tile);
+            }
+            if (!tile.image.isNull()) {
+                painter.drawImage(tileRect(tileRow, tileCol).topLeft(), tile.image);
+            }
+        }
+    }
+
+    if (m_hoverCell >= 0) {
+        QRect rect = cellRect(m_hoverCell / m_numCols, m_hoverCell % m_numCols);
+        if (rect.intersects(dirty)) {
+            painter.setFont(cellFont(font(), m_cellSize));
+            m_cells[m_hoverCell].paint(painter, rect, true);
+        }
+    }
+
+    trimTiles();
+}
+
+// Drop the images of tiles out of view once they take up more than
+// TileCacheKB
+void BoardWidget::trimTiles()
+{
+    int tileSize = qRound(m_tileCells * pitch() * devicePixelRatioF());
+    int tileKB = qMax(1, tileSize * tileSize / 256);
+    QRect visible = tileRange(viewport()->rect());
+    int numVisible = visible.width() * visible.height();
+    if ((m_tiles.size() - numVisible) * tileKB <= TileCacheKB) {
+        return;
+    }
+
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        QPoint tile(it.key() % m_tileCols, it.key() / m_tileCols);
+        if (!it.value().rendering && !visible.contains(tile)) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// Forget every tile, after the zoom or the board changes
+void BoardWidget::resetTiles()
+{
+    m_layout++;
+    m_tiles.clear();
+}
+
+//
+// Mouse handling
+//
+void BoardWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (m_gameOver) {
+        return;
+    }
+
+    int index = cellIndexAt(event->pos());
+    if (index < 0) {
+        return;
+    }
+    int row = index / m_numCols;
+    int col = index % m_numCols;
+
+    if (event->button() == Qt::LeftButton) {
+        // Left click to clear a cell
+        click(row, col);
+    } else if (event->button() == Qt::RightButton && !m_cells[index].isCleared()) {
+        // Right click to flag a cell
+        rightClick(row, col);
+    }
+}
+
+void BoardWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    setHoverCell(cellIndexAt(event->pos()));
+}
+
+// Ctrl+wheel zooms about the mouse; the wheel alone scrolls
+void BoardWidget::wheelEvent(QWheelEvent *event)
+{
+    if (!(event->modifiers() & Qt::ControlModifier)) {
+        QAbstractScrollArea::wheelEvent(event);
+        return;
+    }
+    int level = 0;
+    while (level < NumZoomLevels - 1 && ZoomLevels[level] < m_cellSize) {
+        level++;
+    }
+    int steps = event->angleDelta().y() / 120;
+    level = qBound(0, level + steps, NumZoomLevels - 1);
+    setCellSize(ZoomLevels[level], event->pos());
+    event->accept();
+}
+
+// Viewport events that QAbstractScrollArea doesn't pass on
+bool BoardWidget::viewportEvent(QEvent *event)
+{
+    if (event->type() == QEvent::Leave) {
+        setHoverCell(-1);
+    }
+    return QAbstractScrollArea::viewportEvent(event);
+}
+
+// Highlight the cell under the mouse and restore the previous one. The
+// highlight is drawn over the cached tile, so only the cells are repainted.
+void BoardWidget::setHoverCell(int index)
+{
+    if (index == m_hoverCell) {
+        return;
+    }
+    if (m_hoverCell >= 0) {
+        viewport()->update(cellRect(m_hoverCell / m_numCols, m_hoverCell % m_numCols));
+    }
+    m_hoverCell = index;
+    if (m_hoverCell >= 0) {
+        viewport()->update(cellRect(m_hoverCell / m_numCols, m_hoverCell % m_numCols));
+    }
+}
+
+//
+// User actions
+//
+void BoardWidget::click(int row, int col)
+{
+    emit GameSignals::getInstance()->playerClickedCell(row, col);
+}
+
+void BoardWidget::rightClick(int row, int col)
+{
+    emit GameSignals::getInstance()->playerFlaggedCell(row, col);
+}
+
+//
+// Handle game state updates trigger by game action signals
+//
+// Apply all of the cells cleared by one player action, in one repaint
+void BoardWidget::clearCells(const RevealDelta &cells)
+{
+    QVector<int> changed;
+    changed.reserve(cells.size());
+    for (const RevealedCell &revealed : cells) {
+        Cell *cell = getCell(revealed.row, revealed.col);
+        if (!cell) {
+            continue;
+        }
+        cell->clear(revealed.count, revealed.hasMine);
+        changed.append(revealed.row * m_numCols + revealed.col);
+    }
+    updateCells(changed);
+}
+
+void BoardWidget::flagCell(int row, int col, bool flagged)
+{
+    Cell *cell = getCell(row, col);
+    if (!cell) {
+        return;
+    }
+
+    cell->flag(flagged);
+    syncAnimation(row * m_numCols + col);
+    updateCell(row * m_numCols + col);
+}
+
+void BoardWidget::misflagCell(int row, int col)
+{
+    Cell *cell = getCell(row, col);
+    if (!cell) {
+        return;
+    }
+
+    cell->misflag();
+    syncAnimation(row * m_numCols + col);
+    updateCell(row * m_numCols + col);
+}
+
+void BoardWidget::explode(int row, int col)
+{
+    Cell *cell = getCell(row, col);
+    if (!cell) {
+        return;
+    }
+
+    cell->explode(m_animationClock->now());
+    syncAnimation(row * m_numCols + col);
+    updateCell(row * m_numCols + col);
+}
+
+void BoardWidget::setMines(const RevealDelta &mines)
+{
+    for (const RevealedCell &mine : mines) {
+        Cell *cell = getCell(mine.row, mine.col);
+        if (cell) {
+            cell->setMine();
+        }
+    }
+}
+
+void BoardWidget::gameWon()
+{
+    for (int index = 0; index < m_cells.size(); index++) {
+        m_cells[index].gameWon();
+        syncAnimation(index);
+    }
+    invalidateTiles();
+    viewport()->update();
+
+    // Don't respond to mouse clicks
+    m_gameOver = true;
+}
+
+void BoardWidget::gameLost()
+{
+    for (int index = 0; index < m_cells.size(); index++) {
+        m_cells[index].gameLost();
+        syncAnimation(index);
+    }
+    invalidateTiles();
+    viewport()->update();
+
+    // Don't respond to mouse clicks
+    m_gameOver = true;
+}
+
+void BoardWidget::showHints(bool showHints)
+{
+    for (Cell &cell : m_cells) {
+        cell.showHints(showHints);
+    }
+}
+
+//
+// Cell animations
+//
+
+// Register or unregister a cell with the animation clock to match its state
+void BoardWidget::syncAnimation(int index)
+{
+    if (m_cells[index].isAnimating()) {
+        m_animationClock->start(index);
+    } else {
+        m_animationClock->stop(index);
+    }
+}
+
+// Advance every running animation to the current clock time,
+// collecting the changed cells into a single repaint. Cells too small to
+// show images don't change on screen, so their tiles are left alone.
+void BoardWidget::advanceAnimations(qint64 now)
+{
+    QVector<int> changed;
+    QVector<int> finished;
+    for (int index : m_animationClock->activeCells()) {
+        if (m_cells[index].advanceAnimation(now)) {
+            changed.append(index);
+        }
+        if (!m_cells[index].isAnimating()) {
+            finished.append(index);
+        }
+    }
+    for (int index : finished) {
+        m_animationClock->stop(index);
+    }
+    if (m_cellSize >= Cell::MinDetailSize) {
+        updateCells(changed);
+    }
+}
+
+// Schedule a repaint of a single cell, redrawing its tile
+void BoardWidget::updateCell(int index)
+{
+    invalidateTile(tileIndex(index));
+    viewport()->update(cellRect(index / m_numCols, index % m_numCols));
+}
+
+// Schedule a single repaint covering a set of cells, redrawing the
+// tiles they are in
+void BoardWidget::updateCells(const QVector<int> &indices)
+{
+    int lastTile = -1;
+    for (int index : indices) {
+        int tile = tileIndex(index);
+        if (tile != lastTile) {
+            invalidateTile(tile);
+            lastTile = tile;
+        }
+    }
+
+    if (indices.size() > MaxDirtyRects) {
+        // Repaint the bounding rectangle rather than building a complex region
+        QRect bounds;
+        for (int index : indices) {
+            bounds |= cellRect(index / m_numCols, index % m_numCols);
+        }
+        viewport()->update(bounds);
+    } else if (!indices.isEmpty()) {
+        QRegion dirty;
+        for (int index : indices) {
+            dirty += cellRect(index / m_numCols, index % m_numCols);
+        }
+        viewport()->update(dirty);
+    }
+}
+
+// Mark a tile as out of date, if it has been drawn
+void BoardWidget::invalidateTile(int key)
+{
+    auto it = m_tiles.find(key);
+    if (it != m_tiles.end()) {
+        it.value().version++;
+    }
+}
+
+// Mark every tile as out of date, after a change to the whole board
+void BoardWidget::invalidateTiles()
+{
+    for (auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+        it.value().version++;
+    }
+}
+
+Cell *BoardWidget::getCell(int row, int col)
+{
+    Cell *cell = nullptr;
+    if (row >= 0 && row < m_numRows && col >= 0 && col < m_numCols) {
+        cell = &m_cells[row * m_numCols + col];
+    }
+
+    return cell;
+}
@@ -0,0 +1,131 @@
+#ifndef BOARDWIDGET_H
+#define BOARDWIDGET_H
+
+#include "Cell.h"
+#include "AnimationClock.h"
+#include "RevealDelta.h"
+#include <QAbstractScrollArea>
+#include <QHash>
+#include <QImage>
+#include <QThreadPool>
+#include <QVector>
+
+// Widget to provide the minesweeper UI
+// Contains no game logic other than detecting user actions
+// and emitting a signal when an action has occurred
+//
+// The whole board is a single widget: cells are painted in one
+// paintEvent and mouse events are mapped to cells here, so the
+// number of widgets does not grow with the board size.
+//
+// The board scrolls inside the widget and can be zoomed from full size
+// down to one pixel per cell. Cells are painted in square tiles, and only
+// the tiles in view are drawn. The cell under the mouse is drawn over its
+// tile, so hovering doesn't invalidate the cache.
+//
+// Tiles are rasterized into images on a pool of worker threads, from a
+// copy of their cells, and composited on the GUI thread. A change to a
+// cell marks its tile out of date; the old image is shown until the new
+// one arrives, so only the tiles a change touches are redrawn.
+
+class BoardWidget : public QAbstractScrollArea
+{
+    Q_OBJECT
+public:
+    explicit BoardWidget(QWidget *parent = nullptr);
+    ~BoardWidget() override;
+    QSize sizeHint() const override;
+
+signals:
+    // Sent from a worker thread when a tile's image is ready
+    void tileRendered(int key, int layout, int version, const QImage &image);
+
+public slots:
+    void zoomIn();
+    void zoomOut();
+    void zoomToFit();
+
+private slots:
+    // Slots to handle Game Signals
+    void startGame(int rows, int cols, int mines);
+    void setMines(const RevealDelta &mines);
+    void flagCell(int row, int col, bool flagged);
+    void clearCells(const RevealDelta &cells);
+    void explode(int row, int col);
+    void misflagCell(int row, int col);
+    void gameWon();
+    void gameLost();
+    void showHints(bool showHints);
+    // Slots to handle user actions
+    void click(int row, int col);
+    void rightClick(int row, int col);
+    // Slot to handle animation clock ticks
+    void advanceAnimations(qint64 now);
+    // Slot to handle images from the tile workers
+    void showTile(int key, int layout, int version, const QImage &image);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;
+    bool viewportEvent(QEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+private:
+    struct Tile
+    {
+        Tile() : version(0), imageVersion(-1), rendering(false) {}
+        // Last image drawn for the tile, possibly out of date
+        QImage image;
+        // Bumped whenever a cell in the tile changes
+        int version;
+        int imageVersion;
+        bool rendering;
+    };
+
+    Cell *getCell(int row, int col);
+    int spacing() const;
+    int pitch() const;
+    QSize boardSize() const;
+    QPoint boardOrigin() const;
+    QRect cellRect(int row, int col) const;
+    int cellIndexAt(const QPoint &pos) const;
+    int fitCellSize(const QSize &area) const;
+    void setCellSize(int cellSize, const QPoint &anchor);
+    void updateScrollBars();
+    int tileIndex(int cellIndex) const;
+    QRect tileRect(int tileRow, int tileCol) const;
+    QRect tileRange(const QRect &area) const;
+    void renderTile(int tileRow, int tileCol, Tile &tile);
+    void trimTiles();
+    void resetTiles();
+    void setHoverCell(int index);
+    void updateCell(int index);
+    void updateCells(const QVector<int> &indices);
+    void invalidateTile(int key);
+    void invalidateTiles();
+    void syncAnimation(int index);
+
+private:
+    QVector<Cell> m_cells;
+    AnimationClock *m_animationClock;
+    // Tiles drawn so far, keyed by tile row * m_tileCols + tile column
+    QHash<int, Tile> m_tiles;
+    QThreadPool m_renderPool;
+    // Bumped when the tiles are laid out again, so that images still
+    // being drawn for the old layout are dropped
+    int m_layout;
+    int m_numRows;
+    int m_numCols;
+    // Zoom level: width and height of a cell, in pixels
+    int m_cellSize;
+    // Tiles are m_tileCells x m_tileCells cells at the current zoom
+    int m_tileCells;
+    int m_tileCols;
+    int m_hoverCell;
+    bool m_gameOver;
+};
+
+#endif // BOARDWIDGET_H
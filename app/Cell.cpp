@@ -0,0 +1,259 @@
+#include "Cell.h"
+#include "GlyphCache.h"
+#include <QPainter>
+#include <QDebug>
+
+namespace {
+
+// Size of images drawn in a cell
+const int ImageSize = 30;
+
+// Background colors
+const QColor normalColor(192, 192, 192, 255);
+const QColor highlightColor(210, 210, 210, 255);
+const QColor clearedColor(220, 220, 220, 255);
+const QColor explodeColor(Qt::darkRed);
+
+// Colors of cells too small to show images
+const QColor smallFlagColor(Qt::red);
+const QColor smallMineColor(Qt::black);
+
+}
+
+Cell::Cell()
+{
+    // Initialize state
+    m_color = normalColor;
+    m_sprite = SpriteAtlas::Blank;
+    m_count = 0;
+    m_playingAnimation = false;
+    m_loopingAnimation = false;
+    m_animationDelay = 0;
+    m_animationCount = 0;
+    m_animationStart = 0;
+    m_cleared = false;
+    m_hasMine = false;
+    m_flagged = false;
+    m_showHints = false;
+}
+
+// Draw the cell into its rectangle on the board, using the current color
+// or the highlight color
+void Cell::paint(QPainter &painter, const QRect &rect, bool highlighted) const
+{
+    // Too small for text or images: show flags and mines by color alone
+    if (rect.width() < MinDetailSize) {
+        QColor color = backgroundColor(highlighted);
+        if (m_flagged && !m_cleared) {
+            color = smallFlagColor;
+        } else if (m_sprite == SpriteAtlas::Mine) {
+            color = smallMineColor;
+        }
+        painter.fillRect(rect, color);
+        return;
+    }
+
+    painter.fillRect(rect, backgroundColor(highlighted));
+
+    // Cell either displays text (mine count) or an image
+    if (m_count > 0) {
+        GlyphCache::getInstance()->draw(painter, m_count, rect);
+    } else if (m_sprite != SpriteAtlas::Blank) {
+        int size = qMin(ImageSize, rect.height() * 2 / 3);
+        SpriteAtlas::getInstance()->draw(painter, m_sprite, rect, size);
+    }
+}
+
+// Show the contents of a cell
+void Cell::clear(int count, bool mine)
+{
+    m_cleared = true;
+    if (mine) {
+        showImage(SpriteAtlas::Mine);
+    } else if (count > 0) {
+        showCount(count);
+    }
+    m_color = clearedColor;
+}
+
+// Show mine count
+void Cell::showCount(int count)
+{
+    // Clear any image being displayed
+    showImage(SpriteAtlas::Blank);
+    m_playingAnimation = false;
+
+    // Digits are drawn, in their colors, from the glyph cache
+    m_count = count;
+}
+
+// Show an image
+void Cell::showImage(SpriteAtlas::Sprite sprite)
+{
+    m_sprite = sprite;
+    m_count = 0;
+}
+
+//
+// Functions to display an animated image.
+// BoardWidget's animation clock calls advanceAnimation on every tick
+// while isAnimating is true. Frames are chosen from the clock time, so
+// looping animations started at time 0 all stay in phase.
+//
+void Cell::playAnimation(qint64 start)
+{
+    m_playingAnimation = true;
+    m_animationStart = start;
+    m_animationCount = 0;
+    showImage(m_animationImages[m_animationCount]);
+}
+
+void Cell::stopAnimation()
+{
+    m_playingAnimation = false;
+}
+
+bool Cell::isAnimating() const
+{
+    return m_playingAnimation;
+}
+
+// Move to the animation frame for the given clock time.
+// Returns true if the cell needs to be redrawn.
+bool Cell::advanceAnimation(qint64 now)
+{
+    if (!m_playingAnimation) {
+        return false;
+    }
+
+    int frame = static_cast<int>((now - m_animationStart) / m_animationDelay);
+    if (frame >= m_animationImages.size()) {
+        if (m_loopingAnimation) {
+            frame %= m_animationImages.size();
+        } else {
+            stopAnimation();
+            // Keep showing the final animation frame
+            frame = m_animationImages.size() - 1;
+        }
+    }
+    if (frame == m_animationCount) {
+        return false;
+    }
+    m_animationCount = frame;
+    showImage(m_animationImages[m_animationCount]);
+    return true;
+}
+
+// Is this cell showing its contents?
+bool Cell::isCleared() const
+{
+    return m_cleared;
+}
+
+// Use a highlight color while the mouse is over the cell
+QColor Cell::backgroundColor(bool highlighted) const
+{
+    if (m_cleared || !highlighted) {
+        return m_color;
+    }
+    // Use a different color for mines if we are showing hints
+    if (m_showHints && m_hasMine) {
+        return Qt::white;
+    }
+    return highlightColor;
+}
+
+// Called when player clears a cell that contains a mine
+void Cell::explode(qint64 now)
+{
+    m_cleared = true;
+    m_animationImages.clear();
+    m_animationImages.append(SpriteAtlas::ExplosionSmoke1);
+    m_animationImages.append(SpriteAtlas::ExplosionSmoke2);
+    m_animationImages.append(SpriteAtlas::ExplosionSmoke3);
+    m_animationImages.append(SpriteAtlas::ExplosionSmoke4);
+    m_animationImages.append(SpriteAtlas::ExplosionSmoke5);
+    m_animationImages.append(SpriteAtlas::Blank);
+    m_animationImages.append(SpriteAtlas::Blank);
+    m_animationImages.append(SpriteAtlas::Blank);
+    m_animationImages.append(SpriteAtlas::Blank);
+    m_animationImages.append(SpriteAtlas::Blank);
+    m_animationImages.append(SpriteAtlas::Blank);
+    m_animationImages.append(SpriteAtlas::Blank);
+    m_animationImages.append(SpriteAtlas::Blank);
+    m_animationImages.append(SpriteAtlas::Blank);
+    m_animationImages.append(SpriteAtlas::Blank);
+    m_animationImages.append(SpriteAtlas::ExplosionSmoke3);
+    m_animationDelay = 100;
+    m_loopingAnimation = false;
+    playAnimation(now);
+
+    m_color = explodeColor;
+}
+
+// Flag or unflag a cell
+void Cell::flag(bool flagged)
+{
+    m_flagged = flagged;
+
+    if (flagged) {
+        m_animationImages.clear();
+        m_animationImages.append(SpriteAtlas::FlagRed1);
+        m_animationImages.append(SpriteAtlas::FlagRed2);
+        m_animationDelay = 180;
+        m_loopingAnimation = true;
+        playAnimation(0);
+    } else {
+        stopAnimation();
+        showImage(SpriteAtlas::Blank);
+    }
+}
+
+// Called at game end to show that player incorrectly flagged a
+// cell that does not contain a mine
+void Cell::misflag()
+{
+    // Draw flag on a red background
+    stopAnimation();
+    showImage(SpriteAtlas::FlagRed1);
+    m_color = explodeColor;
+}
+
+// Player won
+void Cell::gameWon()
+{
+    // Flags wave faster after winning
+    if (m_flagged) {
+        stopAnimation();
+        m_animationImages.clear();
+        m_animationImages.append(SpriteAtlas::FlagRed1);
+        m_animationImages.append(SpriteAtlas::FlagRed2);
+        m_animationDelay = 100;
+        m_loopingAnimation = true;
+        playAnimation(0);
+    }
+}
+
+// Player lost
+void Cell::gameLost()
+{
+    // Stop flag waving
+    if (m_flagged) {
+        stopAnimation();
+        showImage(SpriteAtlas::FlagRed1);
+    }
+}
+
+// Show debug/cheat hints
+void Cell::showHints(bool showHints)
+{
+    m_showHints = showHints;
+}
+
+// Tell the cell it has a mine.
+// Only used for debug/cheat hints. All other mine logic is handled
+// in the game manager.
+void Cell::setMine()
+{
+    m_hasMine = true;
+}
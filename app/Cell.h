@@ -0,0 +1,63 @@
+#ifndef CELL_H
+#define CELL_H
+
+#include "SpriteAtlas.h"
+#include <QColor>
+#include <QRect>
+#include <QVector>
+
+class QPainter;
+
+// Display state of a single cell on the Minesweeper board
+//
+// Cells are plain values owned by BoardWidget, which paints them all
+// in one pass and forwards mouse and animation events to them.
+
+class Cell
+{
+public:
+    // Cells smaller than this, in pixels, are drawn as a plain color
+    static const int MinDetailSize = 8;
+
+    Cell();
+    void setMine();
+    void clear(int count, bool mine);
+    void flag(bool flagged);
+    void misflag();
+    void explode(qint64 now);
+    void gameWon();
+    void gameLost();
+    void showHints(bool showHints);
+    bool isCleared() const;
+    bool isAnimating() const;
+    bool advanceAnimation(qint64 now);
+    void paint(QPainter &painter, const QRect &rect, bool highlighted) const;
+
+private:
+    QColor backgroundColor(bool highlighted) const;
+    void showImage(SpriteAtlas::Sprite sprite);
+    void showCount(int count);
+    void playAnimation(qint64 start);
+    void stopAnimation();
+
+private:
+    // Contents
+    SpriteAtlas::Sprite m_sprite;
+    // Mine count shown, or 0 for none
+    int m_count;
+    QColor m_color;
+    // State
+    bool m_cleared;
+    bool m_hasMine;
+    bool m_flagged;
+    bool m_showHints;
+    // Animations
+    QVector<SpriteAtlas::Sprite> m_animationImages;
+    int m_animationDelay;
+    int m_animationCount;
+    qint64 m_animationStart;
+    bool m_playingAnimation;
+    bool m_loopingAnimation;
+};
+
+#endif // CELL_H
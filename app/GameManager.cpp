@@ -0,0 +1,298 @@
+#include "GameManager.h"
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTimer>
+
+namespace {
+
+// Boards kept ready for each board configuration
+const int PoolCapacity = 2;
+
+// Time the UI spends handling events before letting a frame be painted
+const int DrainBudgetMs = 4;
+
+// Replayed actions are sent once a frame
+const int ReplayFrameMs = 16;
+
+// How often commands the engine had no room for are retried
+const int UnsentRetryMs = 1;
+
+}
+
+GameManager::GameManager(QObject *parent) : QObject(parent), m_boardPool(PoolCapacity)
+{
+    m_game = 0;
+    m_replayNext = 0;
+    m_replaySpeed = 1.0;
+    m_replayTimer.setInterval(ReplayFrameMs);
+    connect(&m_replayTimer, &QTimer::timeout, this, &GameManager::replayActions);
+    m_unsentTimer.setInterval(UnsentRetryMs);
+    connect(&m_unsentTimer, &QTimer::timeout, this, &GameManager::sendUnsentCommands);
+
+    // Engine reports state changes through its event queue
+    connect(&m_engineThread, &EngineThread::eventsReady, this, &GameManager::drainEvents,
+            Qt::QueuedConnection);
+    m_engineThread.start();
+
+    // Connect to Game Signals
+    m_gameSignals = GameSignals::getInstance();
+    connect(m_gameSignals, &GameSignals::startGame, this, &GameManager::startGame);
+    connect(m_gameSignals, &GameSignals::prepareBoards, this, &GameManager::prepareBoards);
+    connect(m_gameSignals, &GameSignals::playerClickedCell, this, &GameManager::cellClicked);
+    connect(m_gameSignals, &GameSignals::playerFlaggedCell, this, &GameManager::cellFlagged);
+    connect(m_gameSignals, &GameSignals::saveRecord, this, &GameManager::saveRecord);
+    connect(m_gameSignals, &GameSignals::replayRecord, this, &GameManager::replayRecord);
+    connect(m_gameSignals, &GameSignals::saveGame, this, &GameManager::saveGame);
+    connect(m_gameSignals, &GameSignals::resumeGame, this, &GameManager::resumeGame);
+}
+
+GameManager::~GameManager()
+{
+}
+
+// Start a game, from the given seed if there is one, and otherwise on a
+// board from the pool if one is ready
+void GameManager::startGame(int rows, int cols, int mines, bool noGuess, bool hasSeed,
+                            quint64 seed)
+{
+    stopReplay();
+
+    BoardPool::Config config = { rows, cols, mines, noGuess };
+    BoardPool::Entry entry;
+    bool hasBoard = !hasSeed && m_boardPool.take(config, entry);
+    if (hasSeed) {
+        entry.seed = seed;
+    } else if (!hasBoard) {
+        entry.seed = QRandomGenerator::global()->generate64();
+    }
+
+    // Events still queued from the last game no longer apply
+    m_game++;
+
+    GameCommand command = {};
+    command.game = m_game;
+    command.rows = rows;
+    command.cols = cols;
+    command.mines = mines;
+    command.seed = entry.seed;
+    command.hasBoard = hasBoard;
+    if (noGuess) {
+        command.type = GameCommand::StartNoGuessGame;
+        command.board = entry.board;
+    } else {
+        command.type = GameCommand::StartGame;
+        // Without a pooled board, the engine thread generates one from the seed
+        if (hasBoard) {
+            command.board = entry.board;
+        }
+    }
+    sendCommand(command);
+}
+
+// Start generating boards for a configuration before it is played
+void GameManager::prepareBoards(int rows, int cols, int mines, bool noGuess)
+{
+    BoardPool::Config config = { rows, cols, mines, noGuess };
+    m_boardPool.prepare(config);
+}
+
+// Called when cell is clicked in the UI
+void GameManager::cellClicked(int row, int col)
+{
+    if (m_replayTimer.isActive()) {
+        return;
+    }
+    GameCommand command = {};
+    command.type = GameCommand::Click;
+    command.row = row;
+    command.col = col;
+    sendCommand(command);
+}
+
+// Called when cell is flagged or unflagged in the UI
+void GameManager::cellFlagged(int row, int col)
+{
+    if (m_replayTimer.isActive()) {
+        return;
+    }
+    GameCommand command = {};
+    command.type = GameCommand::Flag;
+    command.row = row;
+    command.col = col;
+    sendCommand(command);
+}
+
+// Write the record of the current game to a file
+void GameManager::saveRecord(const QString &path)
+{
+    GameCommand command = {};
+    command.type = GameCommand::SaveRecord;
+    command.path = path;
+    sendCommand(command);
+}
+
+// Replay a saved game, at the given multiple of the speed it was played at
+void GameManager::replayRecord(const QString &path, double speed)
+{
+    GameRecord record;
+    if (!record.loadFromFile(path)) {
+        emit m_gameSignals->loadFailed(path);
+        return;
+    }
+    stopReplay();
+    m_replay = record;
+    m_replaySpeed = speed > 0 ? speed : 1.0;
+
+    // Events still queued from the last game no longer apply
+    m_game++;
+    emit m_gameSignals->replayStarted(m_replay.rows(), m_replay.cols(), m_replay.numMines());
+
+    GameCommand command = {};
+    command.type = GameCommand::StartGame;
+    command.game = m_game;
+    command.rows = m_replay.rows();
+    command.cols = m_replay.cols();
+    command.mines = m_replay.numMines();
+    command.hasBoard = true;
+    command.board = m_replay.board();
+    sendCommand(command);
+
+    m_replayClock.start();
+    m_replayTimer.start();
+    replayActions();
+}
+
+// Send the engine every replayed action that is due by now. If its
+// command queue fills up, the rest are sent in the next frame.
+void GameManager::replayActions()
+{
+    const QVector<GameRecord::Action> &actions = m_replay.actions();
+    qint64 now = static_cast<qint64>(m_replayClock.elapsed() * m_replaySpeed);
+    while (m_replayNext < actions.size() && actions[m_replayNext].time <= now) {
+        const GameRecord::Action &action = actions[m_replayNext];
+        GameCommand command = {};
+        command.type = action.type == GameRecord::Flag ? GameCommand::Flag : GameCommand::Click;
+        command.row = action.row;
+        command.col = action.col;
+        if (!m_unsent.isEmpty() || !m_engineThread.sendCommand(command)) {
+            return;
+        }
+        m_replayNext++;
+    }
+    if (m_replayNext >= actions.size()) {
+        stopReplay();
+    }
+}
+
+// Save the current game's board, to be resumed later
+void GameManager::saveGame(const QString &path)
+{
+    GameCommand command = {};
+    command.type = GameCommand::SaveSnapshot;
+    command.path = path;
+    sendCommand(command);
+}
+
+// Carry on with a game saved by saveGame()
+void GameManager::resumeGame(const QString &path)
+{
+    Board board;
+    if (!board.loadSnapshot(path) || board.mineTriggered() || board.allCellsCleared()) {
+        emit m_gameSignals->loadFailed(path);
+        return;
+    }
+    stopReplay();
+
+    // Events still queued from the last game no longer apply
+    m_game++;
+    emit m_gameSignals->gameResumed(board.rows(), board.cols(), board.numMines());
+
+    GameCommand command = {};
+    command.type = GameCommand::ResumeGame;
+    command.game = m_game;
+    command.rows = board.rows();
+    command.cols = board.cols();
+    command.mines = board.numMines();
+    command.hasBoard = true;
+    command.board = board;
+    sendCommand(command);
+}
+
+// Send a command to the engine, or keep it to send once the engine's
+// queue has room, after any commands already waiting
+void GameManager::sendCommand(const GameCommand &command)
+{
+    if (m_unsent.isEmpty() && m_engineThread.sendCommand(command)) {
+        return;
+    }
+    m_unsent.enqueue(command);
+    if (!m_unsentTimer.isActive()) {
+        m_unsentTimer.start();
+    }
+}
+
+// Send as many waiting commands as the engine's queue has room for
+void GameManager::sendUnsentCommands()
+{
+    while (!m_unsent.isEmpty() && m_engineThread.sendCommand(m_unsent.head())) {
+        m_unsent.dequeue();
+    }
+    if (m_unsent.isEmpty()) {
+        m_unsentTimer.stop();
+    }
+}
+
+// Stop replaying, leaving the game where the replay got to
+void GameManager::stopReplay()
+{
+    m_replayTimer.stop();
+    m_replay = GameRecord();
+    m_replayNext = 0;
+}
+
+// Forward queued game state changes from the engine to the UI. Stops
+// after a few milliseconds and carries on in the next turn of the event
+// loop, so that a large opening appears progressively.
+void GameManager::drainEvents()
+{
+    m_engineThread.eventsDrained();
+
+    QElapsedTimer timer;
+    timer.start();
+    GameEvent event;
+    while (m_engineThread.nextEvent(event)) {
+        if (event.game != m_game) {
+            continue;
+        }
+        switch (event.type) {
+        case GameEvent::MinesPlaced:
+            emit m_gameSignals->minesPlaced(event.cells);
+            break;
+        case GameEvent::CellsCleared:
+            emit m_gameSignals->cellsCleared(event.cells);
+            break;
+        case GameEvent::CellFlagged:
+            emit m_gameSignals->setCellFlagged(event.row, event.col, event.flagged);
+            break;
+        case GameEvent::Explode:
+            emit m_gameSignals->explode(event.row, event.col);
+            break;
+        case GameEvent::MarkIncorrectlyFlagged:
+            emit m_gameSignals->markIncorrectlyFlaggedCell(event.row, event.col);
+            break;
+        case GameEvent::GameWon:
+            emit m_gameSignals->gameWon();
+            break;
+        case GameEvent::GameLost:
+            emit m_gameSignals->gameLost();
+            break;
+        case GameEvent::NoGuessFailed:
+            emit m_gameSignals->noGuessFailed();
+            break;
+        }
+        if (timer.elapsed() >= DrainBudgetMs) {
+            QTimer::singleShot(0, this, &GameManager::drainEvents);
+            return;
+        }
+    }
+}
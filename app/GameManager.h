@@ -0,0 +1,81 @@
+#ifndef GAMEMANAGER_H
+#define GAMEMANAGER_H
+
+#include "BoardPool.h"
+#include "EngineThread.h"
+#include "GameRecord.h"
+#include "GameSignals.h"
+#include <QElapsedTimer>
+#include <QObject>
+#include <QQueue>
+#include <QTimer>
+
+// Connects the game engine to the UI.
+// Connects to GameSignals signals to know when user actions have
+// occurred, passes them to the GameEngine, and emits signals to
+// communicate the updated game state to the UI.
+//
+// The engine runs on its own thread, so however much work a click
+// causes, the UI stays responsive. Player actions are sent to it as
+// commands, and its state changes are drained from its event queue on
+// the UI thread. If the engine's command queue is full, commands wait
+// here and are sent, in order, once it has room; the UI never blocks.
+//
+// Boards come from a pool filled in the background, so a new game
+// starts without waiting for mines to be placed. No-guess boards depend
+// on the first click: a pooled one is used if the click opens the same
+// area as the centre of the board it was made for, and otherwise the
+// engine thread generates a board for the click. A game started from a
+// given seed skips the pool, so that its board is the one the seed
+// generates.
+//
+// A saved game record can be replayed: its board is started like any
+// other, and its actions are sent to the engine as the replay clock
+// reaches them, all the actions due in a frame at once. The player's
+// own clicks are ignored until the replay is over.
+//
+// A game in progress can be saved as a snapshot of its board, and
+// resumed later from where it was left.
+
+class GameManager : public QObject
+{
+    Q_OBJECT
+public:
+    explicit GameManager(QObject *parent = nullptr);
+    ~GameManager() override;
+
+private slots:
+    void startGame(int rows, int cols, int mines, bool noGuess, bool hasSeed, quint64 seed);
+    void prepareBoards(int rows, int cols, int mines, bool noGuess);
+    void cellClicked(int row, int col);
+    void cellFlagged(int row, int col);
+    void saveRecord(const QString &path);
+    void replayRecord(const QString &path, double speed);
+    void replayActions();
+    void sendUnsentCommands();
+    void saveGame(const QString &path);
+    void resumeGame(const QString &path);
+    void drainEvents();
+
+private:
+    void sendCommand(const GameCommand &command);
+    void stopReplay();
+
+private:
+    EngineThread m_engineThread;
+    BoardPool m_boardPool;
+    GameSignals *m_gameSignals;
+    // Commands waiting for room in the engine's queue, in order
+    QQueue<GameCommand> m_unsent;
+    QTimer m_unsentTimer;
+    // Number of the current game
+    int m_game;
+    // Game being replayed, and the next of its actions to send
+    GameRecord m_replay;
+    int m_replayNext;
+    double m_replaySpeed;
+    QElapsedTimer m_replayClock;
+    QTimer m_replayTimer;
+};
+
+#endif // GAMEMANAGER_H
@@ -5,7 +5,8 @@ GameSignals *GameSignals::instance = 0;
 GameSignals::GameSignals(QObject *parent)
     : QObject{parent}
 {
-
+    // Allow batched updates to be sent through queued connections
+    qRegisterMetaType<RevealDelta>();
 }
 
 GameSignals *GameSignals::getInstance()
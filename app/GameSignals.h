@@ -1,6 +1,7 @@
 #ifndef GAMESIGNALS_H
 #define GAMESIGNALS_H
 
+#include "RevealDelta.h"
 #include <QObject>
 
 // GameSignals contains signals for all game events.
@@ -24,18 +25,33 @@ public:
     static GameSignals *getInstance();
 
 signals:
-    // Start/win/lose
-    void startGame(int rows, int cols, int mines);
+    // Start/win/lose. A game started with a seed has the board that seed
+    // generates; otherwise it gets a random one.
+    void startGame(int rows, int cols, int mines, bool noGuess, bool hasSeed = false,
+                   quint64 seed = 0);
     void gameWon();
     void gameLost();
     // Game initialization
-    void setMine(int row, int col);
+    void prepareBoards(int rows, int cols, int mines, bool noGuess);
+    void minesPlaced(const RevealDelta &mines);
+    // A no-guess board couldn't be generated for the first click
+    void noGuessFailed();
     // Player actions (from UI)
     void playerClickedCell(int row, int col);
     void playerFlaggedCell(int row, int col);
+    // Game records
+    void saveRecord(const QString &path);
+    void replayRecord(const QString &path, double speed);
+    void replayStarted(int rows, int cols, int mines);
+    // Saved games
+    void saveGame(const QString &path);
+    void resumeGame(const QString &path);
+    void gameResumed(int rows, int cols, int mines);
+    // A record or saved game couldn't be read
+    void loadFailed(const QString &path);
     // Game state actions (from backend)
     void setCellFlagged(int row, int col, bool flagged);
-    void clearCell(int row, int col, int count, bool hasMine);
+    void cellsCleared(const RevealDelta &cells);
     void explode(int row, int col);
     void markIncorrectlyFlaggedCell(int row, int col);
     // Debugging signals
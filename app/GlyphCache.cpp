@@ -0,0 +1,80 @@
+#include "GlyphCache.h"
+#include <QColor>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QtMath>
+
+namespace {
+
+// Color of each count
+const char *const CountColors[GlyphCache::MaxCount + 1] = {
+    "Black", "Blue", "Green", "Maroon", "DarkBlue", "Purple", "LightBlue", "Yellow", "White"
+};
+
+}
+
+GlyphCache *GlyphCache::instance = nullptr;
+
+GlyphCache::GlyphCache()
+{
+}
+
+GlyphCache *GlyphCache::getInstance()
+{
+    if (instance == nullptr) {
+        instance = new GlyphCache();
+    }
+    return instance;
+}
+
+// Draw a count from 1 to MaxCount, in the painter's font, centered in rect
+void GlyphCache::draw(QPainter &painter, int count, const QRect &rect)
+{
+    if (count < 1 || count > MaxCount) {
+        return;
+    }
+    qreal devicePixelRatio = painter.device()->devicePixelRatioF();
+    QImage image = strip(painter.font(), devicePixelRatio);
+    int slotWidth = image.width() / MaxCount;
+    int slotHeight = image.height();
+
+    QRect target(0, 0, qRound(slotWidth / devicePixelRatio), qRound(slotHeight / devicePixelRatio));
+    target.moveCenter(rect.center());
+    painter.drawImage(target, image, QRect((count - 1) * slotWidth, 0, slotWidth, slotHeight));
+}
+
+// Return the strip holding every count in a font, drawing it the first
+// time that font is used
+QImage GlyphCache::strip(const QFont &font, qreal devicePixelRatio)
+{
+    QString key = font.key() + QLatin1Char('@') + QString::number(devicePixelRatio);
+    QMutexLocker locker(&m_mutex);
+    auto it = m_strips.find(key);
+    if (it != m_strips.end()) {
+        return it.value();
+    }
+
+    // Slots wide enough for the widest digit, in device pixels
+    QFontMetrics metrics(font);
+    int width = 1;
+    for (int count = 1; count <= MaxCount; count++) {
+        width = qMax(width, metrics.boundingRect(QString::number(count)).width() + 2);
+    }
+    int slotWidth = qCeil(width * devicePixelRatio);
+    int slotHeight = qCeil(metrics.height() * devicePixelRatio);
+
+    QImage image(slotWidth * MaxCount, slotHeight, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.scale(devicePixelRatio, devicePixelRatio);
+    painter.setFont(font);
+    for (int count = 1; count <= MaxCount; count++) {
+        QRectF slot((count - 1) * slotWidth / devicePixelRatio, 0,
+                    slotWidth / devicePixelRatio, slotHeight / devicePixelRatio);
+        painter.setPen(QColor(CountColors[count]));
+        painter.drawText(slot, Qt::AlignCenter, QString::number(count));
+    }
+    painter.end();
+
+    return m_strips.insert(key, image).value();
+}
@@ -0,0 +1,46 @@
+#ifndef GLYPHCACHE_H
+#define GLYPHCACHE_H
+
+#include <QFont>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QRect>
+#include <QString>
+
+class QPainter;
+
+// Shared cache of the mine count digits
+//
+// The eight counts are drawn once for each font and device pixel ratio
+// in use, in their colors, into a single strip of equally sized slots.
+// Cells then copy their count from the strip instead of laying out text
+// every time they are painted.
+//
+// As with SpriteAtlas, the instance must first be created on the GUI
+// thread; after that draw() may be called from any thread.
+
+class GlyphCache
+{
+    // Private constructor so that no objects can be created
+    GlyphCache();
+    static GlyphCache *instance;
+
+public:
+    static const int MaxCount = 8;
+
+    // Public function to get single instance of object
+    static GlyphCache *getInstance();
+
+    void draw(QPainter &painter, int count, const QRect &rect);
+
+private:
+    QImage strip(const QFont &font, qreal devicePixelRatio);
+
+private:
+    // Digit strips, keyed by font and device pixel ratio
+    QHash<QString, QImage> m_strips;
+    QMutex m_mutex;
+};
+
+#endif // GLYPHCACHE_H
@@ -0,0 +1,329 @@
+#include "MainWindow.h"
+#include "BoardSizeDialog.h"
+#include "GameSignals.h"
+
+#include <QFileDialog>
+#include <QInputDialog>
+#include <QLayout>
+#include <QMenuBar>
+#include <QApplication>
+#include <QPushButton>
+#include <QMessageBox>
+#include <QStack>
+#include <QPoint>
+#include <QTimer>
+#include <QDebug>
+
+namespace {
+
+// Preset board sizes: rows, columns and mines
+struct Difficulty {
+    int rows;
+    int cols;
+    int mines;
+};
+const Difficulty Difficulties[] = {
+    { 8, 8, 10 },   // Easy
+    { 16, 16, 40 }, // Medium
+    { 16, 30, 99 }  // Hard
+};
+const int NumDifficulties = sizeof(Difficulties) / sizeof(Difficulties[0]);
+
+}
+
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent)
+{
+    auto mainLayout = new QVBoxLayout();
+
+    // Default board size
+    m_rows = Difficulties[0].rows;
+    m_cols = Difficulties[0].cols;
+    m_numMines = Difficulties[0].mines;
+    // Default custom size
+    m_custRows = 12;
+    m_custCols = 12;
+    m_percentMines = 16;
+    // Boards are random unless asked otherwise
+    m_noGuess = false;
+
+    // Widget to display Minesweeper UI
+    m_ui = new BoardWidget();
+    mainLayout->addWidget(m_ui);
+
+    // Restart button centered at bottom of window
+    auto buttonLayout = new QHBoxLayout();
+    m_restartButton = new QPushButton(tr("Start Over"));
+    m_restartButton->setMinimumWidth(200);
+    connect(m_restartButton, &QPushButton::clicked, this, &MainWindow::restartGame);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(m_restartButton);
+    buttonLayout->addStretch();
+    mainLayout->addLayout(buttonLayout);
+
+    // Set window to main layout created above
+    QWidget *centralWidget = new QWidget;
+    centralWidget->setLayout(mainLayout);
+    setCentralWidget(centralWidget);
+
+    // Menus
+    // Create Game menu
+    auto gameMenu = menuBar()->addMenu(tr("Game"));
+    // New game item
+    auto newGameAction = new QAction(tr("New Game"));
+    connect(newGameAction, &QAction::triggered, this, &MainWindow::restartGame);
+    gameMenu->addAction(newGameAction);
+    // Difficulty
+    gameMenu->addSeparator();
+    auto difficultyMenu = new QMenu(tr("Difficulty"));
+    auto difficultyGroup = new QActionGroup(this);
+    QStringList difficultyLevels = { tr("Easy"), tr("Medium"), tr("Hard"), tr("Custom") };
+    for (int i = 0; i < difficultyLevels.size(); i++) {
+        auto action = new QAction(difficultyLevels[i]);
+        action->setCheckable(true);
+        action->setChecked(i == 0);
+        connect(action, &QAction::triggered, this,  [=]() {this->setDifficulty(i);});
+        difficultyMenu->addAction(action);
+        difficultyGroup->addAction(action);
+    }
+    gameMenu->addMenu(difficultyMenu);
+    // No guessing
+    auto noGuessAction = new QAction(tr("No Guessing"));
+    noGuessAction->setCheckable(true);
+    noGuessAction->setChecked(m_noGuess);
+    connect(noGuessAction, &QAction::toggled, this, &MainWindow::setNoGuess);
+    gameMenu->addAction(noGuessAction);
+#ifndef Q_OS_WASM
+    // Saved games
+    gameMenu->addSeparator();
+    auto saveGameAction = new QAction(tr("Save Game..."));
+    saveGameAction->setShortcuts(QKeySequence::Save);
+    connect(saveGameAction, &QAction::triggered, this, &MainWindow::saveGame);
+    gameMenu->addAction(saveGameAction);
+    auto resumeGameAction = new QAction(tr("Resume Game..."));
+    resumeGameAction->setShortcuts(QKeySequence::Open);
+    connect(resumeGameAction, &QAction::triggered, this, &MainWindow::resumeGame);
+    gameMenu->addAction(resumeGameAction);
+    // Game records
+    gameMenu->addSeparator();
+    auto saveRecordAction = new QAction(tr("Save Game Record..."));
+    connect(saveRecordAction, &QAction::triggered, this, &MainWindow::saveRecord);
+    gameMenu->addAction(saveRecordAction);
+    auto replayAction = new QAction(tr("Replay Game..."));
+    connect(replayAction, &QAction::triggered, this, &MainWindow::replayRecord);
+    gameMenu->addAction(replayAction);
+    // Exit menu item
+    gameMenu->addSeparator();
+    auto exitAction = new QAction(tr("E&xit"));
+    exitAction->setShortcuts(QKeySequence::Close);
+    gameMenu->addAction(exitAction);
+    connect(exitAction, &QAction::triggered, this, &MainWindow::exit);
+#endif
+    // Create View menu
+    auto viewMenu = menuBar()->addMenu(tr("View"));
+    auto zoomInAction = new QAction(tr("Zoom In"));
+    zoomInAction->setShortcuts(QKeySequence::ZoomIn);
+    connect(zoomInAction, &QAction::triggered, m_ui, &BoardWidget::zoomIn);
+    viewMenu->addAction(zoomInAction);
+    auto zoomOutAction = new QAction(tr("Zoom Out"));
+    zoomOutAction->setShortcuts(QKeySequence::ZoomOut);
+    connect(zoomOutAction, &QAction::triggered, m_ui, &BoardWidget::zoomOut);
+    viewMenu->addAction(zoomOutAction);
+    auto fitAction = new QAction(tr("Fit Board"));
+    fitAction->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_0));
+    connect(fitAction, &QAction::triggered, m_ui, &BoardWidget::zoomToFit);
+    viewMenu->addAction(fitAction);
+    // Create About menu
+    auto aboutMenu = menuBar()->addMenu(tr("About"));
+    auto aboutAction = new QAction("About Minesweeper");
+    connect(aboutAction, &QAction::triggered, this, &MainWindow::showAboutDialog);
+    aboutMenu->addAction(aboutAction);
+
+    // Game manager controls the state of the game. As a child of the
+    // window, it stops its engine and board pool threads when closed.
+    m_gameManager = new GameManager(this);
+
+    // Connect to Game Signals
+    auto gameSignals = GameSignals::getInstance();
+    connect(gameSignals, &GameSignals::gameWon, this, &MainWindow::winGame);
+    connect(gameSignals, &GameSignals::gameLost, this, &MainWindow::loseGame);
+    connect(gameSignals, &GameSignals::replayStarted, this, &MainWindow::showLoadedGame);
+    connect(gameSignals, &GameSignals::gameResumed, this, &MainWindow::showLoadedGame);
+    connect(gameSignals, &GameSignals::loadFailed, this, &MainWindow::showLoadError);
+    connect(gameSignals, &GameSignals::noGuessFailed, this, &MainWindow::showNoGuessError);
+
+    // Have boards ready for the presets, then start game
+    prepareBoards();
+    QTimer::singleShot(100, this, &MainWindow::startGame);
+}
+
+MainWindow::~MainWindow()
+{
+
+}
+
+void MainWindow::startGame()
+{
+    emit GameSignals::getInstance()->startGame(m_rows, m_cols, m_numMines, m_noGuess);
+    m_restartButton->setText(tr("Start Over"));
+
+    // Wait for processEvents to redraw widget
+    QApplication::processEvents();
+    // Resize window to show the whole board, as far as the screen allows
+    adjustSize();
+
+    // Uncomment below to show mine locations for debugging/cheating
+//    emit GameSignals::getInstance()->showHints(true);
+}
+
+void MainWindow::restartGame(bool checked)
+{
+    Q_UNUSED(checked);
+    startGame();
+}
+
+void MainWindow::winGame()
+{
+    QMessageBox msg;
+    msg.setText(tr("You Win!"));
+    msg.exec();
+    m_restartButton->setText(tr("Play Again"));
+}
+
+void MainWindow::loseGame()
+{
+    m_restartButton->setText(tr("Play Again"));
+}
+
+void MainWindow::exit()
+{
+    QApplication::quit();
+}
+
+void MainWindow::setDifficulty(int size)
+{
+    switch (size) {
+    case 0:
+    case 1:
+    case 2:
+    default:
+        size = qBound(0, size, NumDifficulties - 1);
+        m_rows = Difficulties[size].rows;
+        m_cols = Difficulties[size].cols;
+        m_numMines = Difficulties[size].mines;
+        break;
+    case 3:
+        BoardSizeDialog dlg(m_custRows, m_custCols, m_percentMines);
+        dlg.exec();
+        if (dlg.result() == QDialog::Rejected) {
+            return;
+        }
+        m_rows = m_custRows;
+        m_cols = m_custCols;
+        m_numMines = static_cast<int>(m_rows * m_cols * m_percentMines / 100);
+        break;
+    }
+
+    startGame();
+}
+
+// Turn generation of boards that can be solved without guessing on or off
+void MainWindow::setNoGuess(bool noGuess)
+{
+    m_noGuess = noGuess;
+    prepareBoards();
+    startGame();
+}
+
+// Ask for boards for each preset to be generated in the background
+void MainWindow::prepareBoards()
+{
+    for (const Difficulty &difficulty : Difficulties) {
+        emit GameSignals::getInstance()->prepareBoards(difficulty.rows, difficulty.cols,
+                                                       difficulty.mines, m_noGuess);
+    }
+}
+
+// Save the record of the current game
+void MainWindow::saveRecord()
+{
+    QString path = QFileDialog::getSaveFileName(this, tr("Save Game Record"), QString(),
+                                                tr("Game Records (*.mswr)"));
+    if (!path.isEmpty()) {
+        emit GameSignals::getInstance()->saveRecord(path);
+    }
+}
+
+// Choose a saved game and the speed to replay it at
+void MainWindow::replayRecord()
+{
+    QString path = QFileDialog::getOpenFileName(this, tr("Replay Game"), QString(),
+                                                tr("Game Records (*.mswr)"));
+    if (path.isEmpty()) {
+        return;
+    }
+    bool ok = false;
+    double speed = QInputDialog::getDouble(this, tr("Replay Game"), tr("Speed:"),
+                                           1.0, 0.1, 1000.0, 1, &ok);
+    if (ok) {
+        emit GameSignals::getInstance()->replayRecord(path, speed);
+    }
+}
+
+// Save the game in progress, to be resumed later
+void MainWindow::saveGame()
+{
+    QString path = QFileDialog::getSaveFileName(this, tr("Save Game"), QString(),
+                                                tr("Saved Games (*.msbs)"));
+    if (!path.isEmpty()) {
+        emit GameSignals::getInstance()->saveGame(path);
+    }
+}
+
+// Carry on with a saved game
+void MainWindow::resumeGame()
+{
+    QString path = QFileDialog::getOpenFileName(this, tr("Resume Game"), QString(),
+                                                tr("Saved Games (*.msbs)"));
+    if (!path.isEmpty()) {
+        emit GameSignals::getInstance()->resumeGame(path);
+    }
+}
+
+// Fit the window to a board being replayed or resumed
+void MainWindow::showLoadedGame()
+{
+    m_restartButton->setText(tr("Start Over"));
+    QApplication::processEvents();
+    adjustSize();
+}
+
+void MainWindow::showLoadError(const QString &path)
+{
+    QMessageBox msg;
+    msg.setText(tr("%1 could not be loaded.").arg(path));
+    msg.exec();
+}
+
+// Explain why a No Guessing game didn't start from the cell clicked
+void MainWindow::showNoGuessError()
+{
+    QMessageBox msg;
+    msg.setText(tr("A board that can be solved without guessing couldn't be made "
+                   "for this click. Try another cell, use fewer mines, "
+                   "or turn off No Guessing."));
+    msg.exec();
+}
+
+void MainWindow::showAboutDialog()
+{
+    QString str =
+            "Qt Minesweeper\n\n"
+            "Minesweeper written in C++ with Qt Widgets\n\n"
+            "https://github.com/DanielMcPherson/QtMinesweeper";
+
+    QMessageBox msg;
+    msg.setText(str);
+    msg.exec();
+
+}
@@ -16,6 +16,7 @@ public:
 
 private:
     void startGame();
+    void prepareBoards();
 
 private slots:
     void restartGame(bool checked);
@@ -23,6 +24,14 @@ private slots:
     void loseGame();
     void exit();
     void setDifficulty(int size);
+    void setNoGuess(bool noGuess);
+    void saveRecord();
+    void replayRecord();
+    void saveGame();
+    void resumeGame();
+    void showLoadedGame();
+    void showLoadError(const QString &path);
+    void showNoGuessError();
     void showAboutDialog();
 
 private:
@@ -32,6 +41,7 @@ private:
     int m_custRows;
     int m_custCols;
     int m_percentMines;
+    bool m_noGuess;
     GameManager *m_gameManager;
     BoardWidget *m_ui;
     QPushButton *m_restartButton;
@@ -0,0 +1,95 @@
+#include "SpriteAtlas.h"
+#include <QPainter>
+#include <QtGlobal>
+
+SpriteAtlas *SpriteAtlas::instance = nullptr;
+
+SpriteAtlas::SpriteAtlas()
+{
+    // Resource path of each sprite, in Sprite order
+    static const char *paths[NumSprites] = {
+        ":/Images/blank.png",
+        ":/Images/mine.png",
+        ":/Images/flagRed1.png",
+        ":/Images/flagRed2.png",
+        ":/Images/flagRed_down.png",
+        ":/Images/flagBlue1.png",
+        ":/Images/flagBlue2.png",
+        ":/Images/flagBlue_down.png",
+        ":/Images/flagGreen1.png",
+        ":/Images/flagGreen2.png",
+        ":/Images/flagGreen_down.png",
+        ":/Images/flagYellow1.png",
+        ":/Images/flagYellow2.png",
+        ":/Images/flagYellow_down.png",
+        ":/Images/explosion1.png",
+        ":/Images/explosion2.png",
+        ":/Images/explosion3.png",
+        ":/Images/explosion4.png",
+        ":/Images/explosion5.png",
+        ":/Images/explosionSmoke1.png",
+        ":/Images/explosionSmoke2.png",
+        ":/Images/explosionSmoke3.png",
+        ":/Images/explosionSmoke4.png",
+        ":/Images/explosionSmoke5.png",
+    };
+
+    // Decode each image once
+    for (int sprite = 0; sprite < NumSprites; sprite++) {
+        QImage image(paths[sprite]);
+        if (image.isNull()) {
+            qWarning("Unable to load sprite %s", paths[sprite]);
+        }
+        m_images.append(image);
+    }
+}
+
+SpriteAtlas *SpriteAtlas::getInstance()
+{
+    if (instance == nullptr) {
+        instance = new SpriteAtlas();
+    }
+    return instance;
+}
+
+// Draw a sprite, scaled to fit a size x size square, centered in rect
+void SpriteAtlas::draw(QPainter &painter, Sprite sprite, const QRect &rect, int size)
+{
+    qreal devicePixelRatio = painter.device()->devicePixelRatioF();
+    QImage image = strip(size, devicePixelRatio);
+    int slot = image.height();
+
+    QRect target(0, 0, size, size);
+    target.moveCenter(rect.center());
+    painter.drawImage(target, image, QRect(sprite * slot, 0, slot, slot));
+}
+
+// Return the strip holding every sprite at a given size,
+// building it the first time that size is used
+QImage SpriteAtlas::strip(int size, qreal devicePixelRatio)
+{
+    int slot = qRound(size * devicePixelRatio);
+    QMutexLocker locker(&m_mutex);
+    auto it = m_strips.find(slot);
+    if (it != m_strips.end()) {
+        return it.value();
+    }
+
+    QImage image(slot * NumSprites, slot, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    for (int sprite = 0; sprite < NumSprites; sprite++) {
+        if (m_images[sprite].isNull()) {
+            continue;
+        }
+        // Keep the aspect ratio and center the image in its slot
+        QImage scaled = m_images[sprite].scaled(slot, slot, Qt::KeepAspectRatio,
+                                                Qt::SmoothTransformation);
+        QPoint topLeft(sprite * slot + (slot - scaled.width()) / 2, (slot - scaled.height()) / 2);
+        painter.drawImage(topLeft, scaled);
+    }
+    painter.end();
+
+    return m_strips.insert(slot, image).value();
+}
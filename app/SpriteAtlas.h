@@ -0,0 +1,73 @@
+#ifndef SPRITEATLAS_H
+#define SPRITEATLAS_H
+
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+#include <QImage>
+#include <QRect>
+
+class QPainter;
+
+// Shared cache of the game's images
+//
+// Every image in resources.qrc is decoded once and scaled once for each
+// target size and device pixel ratio in use, into a single strip of
+// equally sized slots. Callers refer to images by Sprite id instead of
+// resource path and draw them straight from the strip.
+//
+// Strips are images rather than pixmaps so that board tiles can be drawn
+// on worker threads. The instance must first be created on the GUI
+// thread; after that draw() may be called from any thread.
+
+class SpriteAtlas
+{
+    // Private constructor so that no objects can be created
+    SpriteAtlas();
+    static SpriteAtlas *instance;
+
+public:
+    enum Sprite {
+        Blank,
+        Mine,
+        FlagRed1,
+        FlagRed2,
+        FlagRedDown,
+        FlagBlue1,
+        FlagBlue2,
+        FlagBlueDown,
+        FlagGreen1,
+        FlagGreen2,
+        FlagGreenDown,
+        FlagYellow1,
+        FlagYellow2,
+        FlagYellowDown,
+        Explosion1,
+        Explosion2,
+        Explosion3,
+        Explosion4,
+        Explosion5,
+        ExplosionSmoke1,
+        ExplosionSmoke2,
+        ExplosionSmoke3,
+        ExplosionSmoke4,
+        ExplosionSmoke5,
+        NumSprites
+    };
+
+    // Public function to get single instance of object
+    static SpriteAtlas *getInstance();
+
+    void draw(QPainter &painter, Sprite sprite, const QRect &rect, int size);
+
+private:
+    QImage strip(int size, qreal devicePixelRatio);
+
+private:
+    QVector<QImage> m_images;
+    // Scaled strips, keyed by size in device pixels
+    QHash<int, QImage> m_strips;
+    QMutex m_mutex;
+};
+
+#endif // SPRITEATLAS_H
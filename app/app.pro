@@ -0,0 +1,60 @@
+#-------------------------------------------------
+#
+# Project created by QtCreator 2020-02-07T09:39:46
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = Minesweeper
+TEMPLATE = app
+QMAKE_LFLAGS += -no-pie
+
+# The following define makes your compiler emit warnings if you use
+# any feature of Qt which has been marked as deprecated (the exact warnings
+# depend on your compiler). Please consult the documentation of the
+# deprecated API in order to know how to port your code away from it.
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# You can also make your code fail to compile if you use deprecated APIs.
+# In order to do so, uncomment the following line.
+# You can also select to disable deprecated APIs only up to a certain version of Qt.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+CONFIG += c++11
+
+# Headless game engine
+include(../core/core.pri)
+
+SOURCES += \
+    GameSignals.cpp \
+        main.cpp \
+        MainWindow.cpp \
+    Cell.cpp \
+    BoardWidget.cpp \
+    GameManager.cpp \
+    BoardSizeDialog.cpp \
+    SpriteAtlas.cpp \
+    GlyphCache.cpp \
+    AnimationClock.cpp
+
+HEADERS += \
+    GameSignals.h \
+        MainWindow.h \
+    Cell.h \
+    BoardWidget.h \
+    GameManager.h \
+    BoardSizeDialog.h \
+    SpriteAtlas.h \
+    GlyphCache.h \
+    AnimationClock.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
+
+RESOURCES += \
+    ../resources.qrc
@@ -0,0 +1,42 @@
+#-------------------------------------------------
+#
+# Benchmarks for the headless game engine and the board widget.
+# Results are written as JSON. The widget runs on the offscreen
+# platform unless another one is asked for, so no display is needed.
+#
+#-------------------------------------------------
+
+QT       = core gui widgets concurrent
+
+TARGET = minesweeper-bench
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# Headless game engine
+include(../core/core.pri)
+
+# Board widget, built from the game's sources
+INCLUDEPATH += ../app
+
+SOURCES += \
+    main.cpp \
+    ../app/GameSignals.cpp \
+    ../app/Cell.cpp \
+    ../app/BoardWidget.cpp \
+    ../app/SpriteAtlas.cpp \
+    ../app/GlyphCache.cpp \
+    ../app/AnimationClock.cpp
+
+HEADERS += \
+    ../app/GameSignals.h \
+    ../app/Cell.h \
+    ../app/BoardWidget.h \
+    ../app/SpriteAtlas.h \
+    ../app/GlyphCache.h \
+    ../app/AnimationClock.h
+
+RESOURCES += \
+    ../resources.qrc
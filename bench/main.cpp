@@ -0,0 +1,326 @@
+#include "Board.h"
+#include "BoardWidget.h"
+#include "ChunkedGameEngine.h"
+#include "FixedGameEngine.h"
+#include "GameEngine.h"
+#include "GameSignals.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <functional>
+#include <limits>
+
+namespace {
+
+// Format of the results, bumped if their fields change meaning
+const int ResultsVersion = 1;
+
+// Board sizes and mine densities (percent of cells) the benchmarks run across
+struct BoardSize {
+    int rows;
+    int cols;
+};
+const BoardSize BoardSizes[] = {
+    { 8, 8 },
+    { 16, 30 },
+    { 100, 100 },
+    { 1000, 1000 },
+    { 4000, 4000 }
+};
+const int Densities[] = { 1, 10, 20, 50, 90 };
+
+// Each benchmark runs for at least this long, and at least this many
+// times. Runs much quicker than their set-up stop after MaxWallTimeMs.
+const int MinTimeMs = 200;
+const int MaxWallTimeMs = 2000;
+const int MinRuns = 3;
+
+// Games of random clicks per run of the whole-game benchmarks
+const int NumGames = 1000;
+
+// Chunks crossed by the endless board benchmark, and the chunks it keeps
+// in memory while doing so
+const int EndlessTrip = 1000;
+const int EndlessChunkLimit = 64;
+
+// Results are written here so the work that makes them isn't optimized away
+volatile qint64 sink;
+
+// One board configuration, with its first click kept clear of mines
+struct Config
+{
+    int rows;
+    int cols;
+    int density;
+    int mines;
+    quint64 seed;
+};
+
+// Collects the results as JSON
+class Results
+{
+public:
+    // Run a benchmark until it has taken at least MinTimeMs, and record
+    // the mean and fastest time per run. Set-up isn't timed.
+    void benchmark(const QString &name, const Config &config, const std::function<void()> &setUp,
+                   const std::function<void()> &run)
+    {
+        qint64 elapsed = 0;
+        qint64 fastest = std::numeric_limits<qint64>::max();
+        int runs = 0;
+        QElapsedTimer wallTimer;
+        wallTimer.start();
+        QElapsedTimer timer;
+        while ((elapsed < MinTimeMs * 1000000LL && wallTimer.elapsed() < MaxWallTimeMs) || runs < MinRuns) {
+            setUp();
+            timer.start();
+            run();
+            qint64 time = timer.nsecsElapsed();
+            elapsed += time;
+            fastest = qMin(fastest, time);
+            runs++;
+        }
+
+        QJsonObject result;
+        result["name"] = name;
+        result["rows"] = config.rows;
+        result["cols"] = config.cols;
+        result["density"] = config.density;
+        result["mines"] = config.mines;
+        result["runs"] = runs;
+        result["meanMs"] = elapsed / 1e6 / runs;
+        result["minMs"] = fastest / 1e6;
+        m_results.append(result);
+
+        // Progress, kept off the JSON
+        QTextStream err(stderr);
+        err << QString("%1 %2x%3 %4%: %5 ms\n").arg(name, -20).arg(config.rows).arg(config.cols)
+               .arg(config.density).arg(elapsed / 1e6 / runs, 0, 'f', 3);
+    }
+
+    QJsonDocument document() const
+    {
+        QJsonObject root;
+        root["version"] = ResultsVersion;
+        root["qtVersion"] = QString(qVersion());
+        root["platform"] = QGuiApplication::platformName();
+        root["results"] = m_results;
+        return QJsonDocument(root);
+    }
+
+private:
+    QJsonArray m_results;
+};
+
+// Start a game on a newly generated board. The engine then holds the only
+// copy of the board, so the benchmarks don't time the engine detaching it.
+void startGame(GameEngine &engine, const Config &config)
+{
+    Board board;
+    board.initialize(config.rows, config.cols, config.mines, config.seed,
+                     config.rows / 2, config.cols / 2);
+    engine.startGame(board);
+}
+
+// Play games of random clicks on Hard boards until each is won or lost
+template <typename Engine>
+void playRandomGames(Engine &engine, quint64 seed)
+{
+    for (int game = 0; game < NumGames; game++) {
+        engine.startGame(16, 30, 99, seed + game);
+        Random random(seed - game);
+        while (engine.state() == GameEngine::Playing) {
+            engine.cellClicked(static_cast<int>(random.bounded(16)), static_cast<int>(random.bounded(30)));
+        }
+    }
+}
+
+// Engine benchmarks for one board configuration
+void benchmarkEngine(Results &results, const Config &config)
+{
+    int centreRow = config.rows / 2;
+    int centreCol = config.cols / 2;
+    Board board;
+    board.initialize(config.rows, config.cols, config.mines, config.seed, centreRow, centreCol);
+
+    // Board setup: placing mines, then counting them for every cell
+    quint64 seed = config.seed;
+    Board generated;
+    results.benchmark("initialize", config, [&]() {
+        seed++;
+    }, [&]() {
+        generated.initialize(config.rows, config.cols, config.mines, seed);
+    });
+
+    // Chord checks over the whole board, with every mine flagged
+    Board flagged = board;
+    for (int row = 0; row < config.rows; row++) {
+        for (int col = 0; col < config.cols; col++) {
+            if (flagged.hasMine(row, col)) {
+                flagged.toggleFlag(row, col);
+            }
+        }
+    }
+    results.benchmark("numSurroundingFlags", config, []() {
+    }, [&]() {
+        qint64 total = 0;
+        for (int row = 0; row < config.rows; row++) {
+            for (int col = 0; col < config.cols; col++) {
+                total += flagged.numSurroundingFlags(row, col);
+            }
+        }
+        sink = total;
+    });
+
+    // Opening reveal: the first click opens the area around it
+    GameEngine engine;
+    results.benchmark("openingReveal", config, [&]() {
+        startGame(engine, config);
+    }, [&]() {
+        engine.cellClicked(centreRow, centreCol);
+    });
+
+    // Flood fill: a flag inside the opening makes the engine fill it span
+    // by span rather than revealing the precomputed opening. Openings too
+    // small to hold a flag are skipped.
+    int opening = board.openingAt(centreRow, centreCol);
+    int flagRow = -1;
+    int flagCol = -1;
+    for (int row = 0; opening >= 0 && row < config.rows && flagRow < 0; row++) {
+        for (int col = 0; col < config.cols; col++) {
+            if ((row != centreRow || col != centreCol) && board.openingAt(row, col) == opening) {
+                flagRow = row;
+                flagCol = col;
+                break;
+            }
+        }
+    }
+    if (flagRow >= 0) {
+        results.benchmark("floodFill", config, [&]() {
+            startGame(engine, config);
+            engine.cellFlagged(flagRow, flagCol);
+        }, [&]() {
+            engine.cellClicked(centreRow, centreCol);
+        });
+    }
+
+    // Losing: clicking a mine clears the rest of the board
+    int mineRow = -1;
+    int mineCol = -1;
+    for (int row = 0; row < config.rows && mineRow < 0; row++) {
+        for (int col = 0; col < config.cols; col++) {
+            if (board.hasMine(row, col)) {
+                mineRow = row;
+                mineCol = col;
+                break;
+            }
+        }
+    }
+    if (mineRow >= 0) {
+        results.benchmark("clearAllCells", config, [&]() {
+            startGame(engine, config);
+        }, [&]() {
+            engine.cellClicked(mineRow, mineCol);
+        });
+    }
+}
+
+// Widget benchmarks for one board size. The widget doesn't place mines,
+// so these run once per size rather than for every density.
+void benchmarkWidget(Results &results, const Config &config)
+{
+    // Laying out the cells for a new game
+    results.benchmark("widget.startGame", config, []() {
+    }, [&]() {
+        emit GameSignals::getInstance()->startGame(config.rows, config.cols, config.mines, false);
+    });
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    // Draw without a display unless a platform has been chosen
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    Results results;
+    // The board widget follows the game signals, like the game's own
+    BoardWidget widget;
+
+    for (const BoardSize &size : BoardSizes) {
+        for (int density : Densities) {
+            Config config = { size.rows, size.cols, density,
+                              qMax(1, static_cast<int>(qint64(size.rows) * size.cols * density / 100)), 1 };
+            benchmarkEngine(results, config);
+        }
+        Config config = { size.rows, size.cols, 0, 0, 1 };
+        benchmarkWidget(results, config);
+    }
+
+    // Whole games on a runtime-sized board and on a compile-time sized one
+    quint64 seed = 1;
+    Config hard = { 16, 30, 20, 99, seed };
+    GameEngine engine;
+    results.benchmark("randomGames", hard, [&]() {
+        seed++;
+    }, [&]() {
+        playRandomGames(engine, seed);
+    });
+    FixedGameEngine<16, 30> fixedEngine;
+    results.benchmark("randomGames.fixed", hard, [&]() {
+        seed++;
+    }, [&]() {
+        playRandomGames(fixedEngine, seed);
+    });
+
+    // A huge board: only the chunks the first click reaches are generated
+    ChunkedGameEngine chunkedEngine;
+    Config huge = { 100000, 100000, 15, 1500000000, seed };
+    results.benchmark("chunked.firstClick", huge, [&]() {
+        seed++;
+        chunkedEngine.startGame(huge.rows, huge.cols, huge.mines, seed, 50000, 50000);
+    }, [&]() {
+        chunkedEngine.cellClicked(50000, 50000);
+    });
+
+    // An endless board: a trip out along a row, opening a cell in each of
+    // EndlessTrip chunks, then back, so chunks left behind are evicted and
+    // rebuilt from their saved changes
+    Config endless = { 0, 0, 15, 0, seed };
+    results.benchmark("chunked.endless", endless, [&]() {
+        seed++;
+        chunkedEngine.board().setChunkLimit(EndlessChunkLimit);
+        chunkedEngine.startEndlessGame(endless.density / 100.0, seed, 0, 0);
+    }, [&]() {
+        for (int pass = 0; pass < 2; pass++) {
+            for (int chunk = 0; chunk < EndlessTrip; chunk++) {
+                int col = (pass == 0 ? chunk : EndlessTrip - 1 - chunk) * ChunkedBoard::ChunkSize;
+                while (chunkedEngine.board().hasMine(0, col)) {
+                    col++;
+                }
+                chunkedEngine.cellClicked(0, col);
+            }
+        }
+        sink = chunkedEngine.board().numSavedChunks();
+    });
+
+    // Results go to the file named on the command line, or to stdout
+    QByteArray json = results.document().toJson();
+    QStringList args = app.arguments();
+    if (args.size() > 1) {
+        QFile file(args[1]);
+        if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size()) {
+            QTextStream(stderr) << "Can't write " << args[1] << "\n";
+            return 1;
+        }
+    } else {
+        QTextStream(stdout) << json;
+    }
+    return 0;
+}
@@ -0,0 +1,867 @@
+#include "Board.h"
+#include <QFile>
+#include <QThread>
+#include <QtAlgorithms>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// Boards with at least this many cells label their openings in parallel
+const int ParallelLabelCells = 1 << 18;
+
+// Cells to the west of each cell in a word, shifted into place.
+// A cell's west neighbor is one bit lower and carries in from the top bit
+// of the previous word. Rows have sentinel cells at both ends and the
+// planes have guard words at both ends, so the neighboring word is always
+// there to read.
+inline quint64 westOf(const quint64 *plane, int word)
+{
+    return (plane[word] << 1) | (plane[word - 1] >> 63);
+}
+
+// Cells to the east of each cell in a word, shifted into place
+inline quint64 eastOf(const quint64 *plane, int word)
+{
+    return (plane[word] >> 1) | (plane[word + 1] << 63);
+}
+
+// Add three one-bit planes, giving a sum bit and a carry bit per cell
+inline void fullAdd(quint64 a, quint64 b, quint64 c, quint64 &sum, quint64 &carry)
+{
+    quint64 ab = a ^ b;
+    sum = ab ^ c;
+    carry = (a & b) | (ab & c);
+}
+
+
+// A horizontal run of cells with no surrounding mines
+struct Run
+{
+    int row;
+    int left;
+    int right;
+};
+
+// Runs found in a band of rows, joined into trees within the band
+struct Band
+{
+    int firstRow;
+    int lastRow;
+    QVector<Run> runs;
+    QVector<int> parent;
+    // Index of the first run of each row in the band, plus one past the end
+    QVector<int> rowStart;
+};
+
+int findRoot(QVector<int> &parent, int run)
+{
+    while (parent[run] != run) {
+        parent[run] = parent[parent[run]];
+        run = parent[run];
+    }
+    return run;
+}
+
+void join(QVector<int> &parent, int a, int b)
+{
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if (a != b) {
+        parent[qMax(a, b)] = qMin(a, b);
+    }
+}
+
+// Join the runs of two neighboring rows that touch, diagonals included.
+// Runs are in column order, so one sweep over both rows finds them all.
+void joinRows(QVector<int> &parent, const QVector<Run> &runsA, int firstA, int endA, int offsetA,
+              const QVector<Run> &runsB, int firstB, int endB, int offsetB)
+{
+    int a = firstA;
+    int b = firstB;
+    while (a < endA && b < endB) {
+        if (runsA[a].right + 1 >= runsB[b].left && runsB[b].right + 1 >= runsA[a].left) {
+            join(parent, offsetA + a, offsetB + b);
+        }
+        if (runsA[a].right < runsB[b].right) {
+            a++;
+        } else {
+            b++;
+        }
+    }
+}
+
+// Bits from..to (inclusive) of a word
+inline quint64 spanMask(int from, int to)
+{
+    return (~quint64(0) >> (63 - (to - from))) << from;
+}
+
+// Snapshot files start with a header, in the byte order of the machine
+// that wrote them, on a page of its own. The mine, flag and cleared planes
+// follow, each starting on a new page. The count planes aren't saved,
+// since they follow from the mines. (Versions 1 and 2 saved them, and
+// version 1 also held per-cell neighbor counters.)
+const char SnapshotMagic[4] = { 'M', 'S', 'B', 'S' };
+const quint32 SnapshotVersion = 3;
+const int NumSnapshotPlanes = 3;
+const quint32 SnapshotByteOrder = 0x01020304;
+const qint64 SnapshotPageSize = 4096;
+
+struct SnapshotHeader
+{
+    char magic[4];
+    quint32 version;
+    quint32 byteOrder;
+    qint32 rows;
+    qint32 cols;
+    qint32 numMines;
+    qint32 numLeftToClear;
+    qint32 mineTriggered;
+    qint32 numWords;
+    qint32 reserved;
+    qint64 fileSize;
+};
+
+// Round a size up to a whole number of pages
+qint64 pageAlign(qint64 size)
+{
+    return (size + SnapshotPageSize - 1) / SnapshotPageSize * SnapshotPageSize;
+}
+
+// Copy data into a mapped file a page at a time, skipping the pages that
+// already hold it, so that they are not written back
+void copyChangedPages(uchar *to, const void *from, qint64 size)
+{
+    const uchar *source = static_cast<const uchar *>(from);
+    for (qint64 offset = 0; offset < size; offset += SnapshotPageSize) {
+        size_t length = static_cast<size_t>(qMin(SnapshotPageSize, size - offset));
+        if (memcmp(to + offset, source + offset, length) != 0) {
+            memcpy(to + offset, source + offset, length);
+        }
+    }
+}
+
+}
+
+Board::Board()
+{
+    // Initialize member variables
+    m_rows = 0;
+    m_cols = 0;
+    m_wordsPerRow = 0;
+    m_stride = 0;
+    for (int i = 0; i < NumNeighbors; i++) {
+        m_neighborOffsets[i] = 0;
+    }
+    m_numMines = 0;
+    m_numLeftToClear = 0;
+    m_mineTriggered = false;
+    m_openingsLabelled = false;
+    m_threeBV = 0;
+}
+
+// Initialize board with given dimensions and number of mines.
+// The same dimensions, mine count and seed always give the same board.
+// If a safe cell is given, no mines are placed on it or its neighbors,
+// so that clicking it first opens up an area of the board.
+void Board::initialize(int rows, int cols, int numMines, quint64 seed, int safeRow, int safeCol)
+{
+    setSize(rows, cols);
+
+    // Initialize board with empty cells, and the sentinels cleared
+    int numWords = (m_rows + 2) * m_wordsPerRow + 2;
+    m_mines.fill(0, numWords);
+    m_flags.fill(0, numWords);
+    m_cleared.fill(0, numWords);
+    for (int word = 0; word < numWords; word++) {
+        m_cleared[word] = ~validBits(word);
+    }
+    for (int plane = 0; plane < NumCountPlanes; plane++) {
+        m_counts[plane].fill(0, numWords);
+    }
+
+    // Add mines
+    int numSafe = 0;
+    if (safeRow >= 0 && safeRow < m_rows && safeCol >= 0 && safeCol < m_cols) {
+        numSafe = (qMin(safeRow + 1, m_rows - 1) - qMax(safeRow - 1, 0) + 1)
+                * (qMin(safeCol + 1, m_cols - 1) - qMax(safeCol - 1, 0) + 1);
+    } else {
+        safeRow = -1;
+    }
+    numMines = qBound(0, numMines, m_rows * m_cols - numSafe);
+    m_random.setSeed(seed);
+    setMines(numMines, safeRow, safeCol);
+    m_mineTriggered = false;
+    m_openingsLabelled = false;
+    m_numMines = numMines;
+    m_numLeftToClear = m_rows * m_cols - numMines;
+}
+
+// Remember the number of rows and columns, and lay out the planes: a
+// sentinel column at each end of every row, a sentinel row above and below
+// the board, and a guard word at each end
+void Board::setSize(int rows, int cols)
+{
+    m_rows = rows;
+    m_cols = cols;
+    m_wordsPerRow = (m_cols + 2 + 63) / 64;
+    m_stride = m_wordsPerRow * 64;
+    int offsets[NumNeighbors] = { -m_stride - 1, -m_stride, -m_stride + 1, -1,
+                                  1, m_stride - 1, m_stride, m_stride + 1 };
+    for (int i = 0; i < NumNeighbors; i++) {
+        m_neighborOffsets[i] = offsets[i];
+    }
+}
+
+int Board::rows() const
+{
+    return m_rows;
+}
+
+int Board::cols() const
+{
+    return m_cols;
+}
+
+// Number of mines actually placed
+int Board::numMines() const
+{
+    return m_numMines;
+}
+
+// Does a given cell contain a mine?
+bool Board::hasMine(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return false;
+    }
+    return mineAt(cellIndex(row, col));
+}
+
+// Return the number of neighboring cells that contain mines
+int Board::mineCount(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return false;
+    }
+    return countAt(cellIndex(row, col));
+}
+
+// Toggle the flag marking for a cell
+void Board::toggleFlag(int row, int col)
+{
+    if (isValidCell(row, col)) {
+        int index = cellIndex(row, col);
+        bool flagged = !flaggedAt(index);
+        setBit(m_flags, index, flagged);
+    }
+}
+
+// Clear a cell, revealing a mine or count
+void Board::clearCell(int row, int col)
+{
+    if (isValidCell(row, col)) {
+        clearCellAt(cellIndex(row, col));
+    }
+}
+
+// Unchecked clearCell(), by cell index
+void Board::clearCellAt(int index)
+{
+    if (!clearedAt(index)) {
+        setBit(m_cleared, index, true);
+        if (mineAt(index)) {
+            m_mineTriggered = true;
+        } else {
+            m_numLeftToClear--;
+        }
+    }
+}
+
+// Is this cell flagged?
+bool Board::isFlagged(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return false;
+    }
+    return flaggedAt(cellIndex(row, col));
+}
+
+// Has this cell been cleared?
+bool Board::isCleared(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return false;
+    }
+    return clearedAt(cellIndex(row, col));
+}
+
+// Has a mine been triggered?
+bool Board::mineTriggered()
+{
+    return m_mineTriggered;
+}
+
+// Have all cells been cleared?
+bool Board::allCellsCleared()
+{
+    return m_numLeftToClear <= 0;
+}
+
+// Return the number of surrounding cells that have been flagged
+int Board::numSurroundingFlags(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return 0;
+    }
+    return surroundingFlagsAt(cellIndex(row, col));
+}
+
+// Return the number of surrounding cells that have been cleared
+int Board::numSurroundingCleared(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return 0;
+    }
+    return surroundingClearedAt(cellIndex(row, col));
+}
+
+// Unchecked numSurroundingCleared(), by cell index. The sentinels around
+// the board are cleared, but aren't counted.
+int Board::surroundingClearedAt(int index) const
+{
+    int row = rowOf(index);
+    int col = colOf(index);
+    int onBoard = (qMin(row + 1, m_rows - 1) - qMax(row - 1, 0) + 1)
+            * (qMin(col + 1, m_cols - 1) - qMax(col - 1, 0) + 1) - 1;
+    return countAround(m_cleared, index) - (NumNeighbors - onBoard);
+}
+
+// Move a mine to an empty cell, updating the counts around both cells
+void Board::moveMine(int fromRow, int fromCol, int toRow, int toCol)
+{
+    if (!hasMine(fromRow, fromCol) || !isValidCell(toRow, toCol) || hasMine(toRow, toCol)) {
+        return;
+    }
+    int from = cellIndex(fromRow, fromCol);
+    int to = cellIndex(toRow, toCol);
+    setBit(m_mines, from, false);
+    setBit(m_mines, to, true);
+    m_openingsLabelled = false;
+
+    // Sentinel counts are never read, so they can be updated along with
+    // the rest (counts are four bits, so they wrap rather than overflow)
+    for (int i = 0; i < NumNeighbors; i++) {
+        int neighbor = from + m_neighborOffsets[i];
+        setMineCount(neighbor, (countAt(neighbor) - 1) & 15);
+    }
+    for (int i = 0; i < NumNeighbors; i++) {
+        int neighbor = to + m_neighborOffsets[i];
+        setMineCount(neighbor, (countAt(neighbor) + 1) & 15);
+    }
+}
+
+// Index of the opening a cell belongs to, or -1 if it has surrounding mines
+int Board::openingAt(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return -1;
+    }
+    labelOpenings();
+    // The last run of the row starting at or before the column
+    const OpeningRun *first = m_runs.constData() + m_rowRuns[row];
+    const OpeningRun *last = m_runs.constData() + m_rowRuns[row + 1];
+    const OpeningRun *run = std::upper_bound(first, last, col, [](int col, const OpeningRun &run) {
+        return col < run.left;
+    });
+    if (run == first || (--run)->right < col) {
+        return -1;
+    }
+    return run->opening;
+}
+
+// Is any cell of an opening flagged? Flags stop an opening from being
+// revealed past them, so such openings have to be flood filled.
+bool Board::openingHasFlags(int opening)
+{
+    labelOpenings();
+    for (int i = m_openingStart[opening]; i < m_openingStart[opening + 1]; i++) {
+        int word = m_openingWords[i];
+        if (m_flags[word] & m_openingMasks[i] & zeroBits(word)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Clear an opening and its border, appending the newly cleared cells.
+// Flagged border cells are left alone.
+void Board::revealOpening(int opening, RevealDelta &revealed)
+{
+    labelOpenings();
+    for (int i = m_openingStart[opening]; i < m_openingStart[opening + 1]; i++) {
+        int word = m_openingWords[i];
+        quint64 bits = m_openingMasks[i] & ~m_cleared[word] & ~m_flags[word];
+        if (!bits) {
+            continue;
+        }
+        m_cleared[word] |= bits;
+        m_numLeftToClear -= qPopulationCount(bits);
+
+        while (bits) {
+            int index = word * 64 + qCountTrailingZeroBits(bits);
+            bits &= bits - 1;
+            RevealedCell cell;
+            cell.row = rowOf(index);
+            cell.col = colOf(index);
+            cell.count = static_cast<quint8>(countAt(index));
+            cell.hasMine = false;
+            revealed.append(cell);
+        }
+    }
+}
+
+// Number of openings on the board
+int Board::numOpenings()
+{
+    labelOpenings();
+    return m_openingStart.size() - 1;
+}
+
+// Bechtel's Board Benchmark Value: the fewest clicks that clear the board,
+// one per opening plus one per cell outside every opening and its border
+int Board::threeBV()
+{
+    labelOpenings();
+    return m_threeBV;
+}
+
+// Can a board of this size be laid out? Every cell index, sentinels and
+// guard words included, must fit an int.
+bool Board::isValidSize(quint64 rows, quint64 cols)
+{
+    const quint64 maxIndex = std::numeric_limits<int>::max();
+    if (rows == 0 || cols == 0 || rows > maxIndex || cols > maxIndex) {
+        return false;
+    }
+    quint64 numWords = (rows + 2) * ((cols + 2 + 63) / 64) + 2;
+    return numWords * 64 <= maxIndex;
+}
+
+// Save the board's state to a snapshot file. If the file already holds a
+// snapshot of the board, only the pages that have changed are written.
+bool Board::saveSnapshot(const QString &path) const
+{
+    if (m_mines.isEmpty()) {
+        return false;
+    }
+    int numWords = m_mines.size();
+    qint64 planeBytes = pageAlign(qint64(numWords) * sizeof(quint64));
+
+    SnapshotHeader header = {};
+    memcpy(header.magic, SnapshotMagic, sizeof(header.magic));
+    header.version = SnapshotVersion;
+    header.byteOrder = SnapshotByteOrder;
+    header.rows = m_rows;
+    header.cols = m_cols;
+    header.numMines = m_numMines;
+    header.numLeftToClear = m_numLeftToClear;
+    header.mineTriggered = m_mineTriggered;
+    header.numWords = numWords;
+    header.fileSize = SnapshotPageSize + NumSnapshotPlanes * planeBytes;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite) || !file.resize(header.fileSize)) {
+        return false;
+    }
+    uchar *data = file.map(0, header.fileSize);
+    if (!data) {
+        return false;
+    }
+    const QVector<quint64> *planes[] = { &m_mines, &m_flags, &m_cleared };
+    for (int plane = 0; plane < NumSnapshotPlanes; plane++) {
+        copyChangedPages(data + SnapshotPageSize + plane * planeBytes, planes[plane]->constData(),
+                         qint64(numWords) * sizeof(quint64));
+    }
+    copyChangedPages(data, &header, sizeof(header));
+    return file.unmap(data);
+}
+
+// Load the board's state from a snapshot file. The planes are copied
+// straight out of the mapped file, and the counts worked out again from
+// the mines. The board is left as it was if the file isn't a snapshot, or
+// holds a board that doesn't add up.
+bool Board::loadSnapshot(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < SnapshotPageSize) {
+        return false;
+    }
+    const uchar *data = file.map(0, file.size());
+    if (!data) {
+        return false;
+    }
+    SnapshotHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, SnapshotMagic, sizeof(header.magic)) != 0
+            || header.version != SnapshotVersion || header.byteOrder != SnapshotByteOrder
+            || header.rows <= 0 || header.cols <= 0 || !isValidSize(header.rows, header.cols)) {
+        return false;
+    }
+
+    // The layout follows from the board size
+    qint64 numWords = (qint64(header.rows) + 2) * ((qint64(header.cols) + 2 + 63) / 64) + 2;
+    if (numWords != header.numWords) {
+        return false;
+    }
+    qint64 planeBytes = pageAlign(numWords * sizeof(quint64));
+    if (header.fileSize != SnapshotPageSize + NumSnapshotPlanes * planeBytes
+            || header.fileSize != file.size()) {
+        return false;
+    }
+
+    Board board;
+    board.setSize(header.rows, header.cols);
+    QVector<quint64> *planes[] = { &board.m_mines, &board.m_flags, &board.m_cleared };
+    for (int plane = 0; plane < NumSnapshotPlanes; plane++) {
+        planes[plane]->resize(static_cast<int>(numWords));
+        memcpy(planes[plane]->data(), data + SnapshotPageSize + plane * planeBytes,
+               numWords * sizeof(quint64));
+    }
+    board.m_numMines = header.numMines;
+    board.m_numLeftToClear = header.numLeftToClear;
+    board.m_mineTriggered = header.mineTriggered != 0;
+    if (!board.isConsistent()) {
+        return false;
+    }
+    for (int plane = 0; plane < NumCountPlanes; plane++) {
+        board.m_counts[plane].fill(0, static_cast<int>(numWords));
+    }
+    board.calcMineCounts();
+    *this = board;
+    return true;
+}
+
+// Do the mine, flag and cleared planes and the counters agree? Checked
+// for loaded snapshots, before the counts are worked out from them: the
+// sentinels must be cleared, with no mines or flags, for the loops that
+// rely on them to stop at the edge of the board.
+bool Board::isConsistent() const
+{
+    qint64 numMines = 0;
+    qint64 numCleared = 0;
+    bool mineCleared = false;
+    for (int word = 0; word < m_mines.size(); word++) {
+        quint64 valid = validBits(word);
+        if (((m_mines[word] | m_flags[word]) & ~valid) || (m_cleared[word] | valid) != ~quint64(0)) {
+            return false;
+        }
+        numMines += qPopulationCount(m_mines[word]);
+        numCleared += qPopulationCount(m_cleared[word] & valid & ~m_mines[word]);
+        mineCleared = mineCleared || (m_cleared[word] & m_mines[word]);
+    }
+    return numMines == m_numMines && mineCleared == m_mineTriggered
+            && m_numLeftToClear == qint64(m_rows) * m_cols - numMines - numCleared;
+}
+
+// Set a specified number of mines randomly on the board, keeping them
+// off the safe cell and its neighbors if safeRow is not negative
+//
+// Uses Floyd's sampling without replacement: each step draws one cell and
+// always places a mine, so the cost is linear in the number of mines no
+// matter how dense the board is. Cells are drawn from the cells outside
+// the safe area, numbered in order, and mapped back to board cells by
+// skipping over the safe ones.
+void Board::setMines(int numMines, int safeRow, int safeCol)
+{
+    int safeCells[9];
+    int numSafe = 0;
+    if (safeRow >= 0) {
+        for (int i = qMax(safeRow - 1, 0); i <= qMin(safeRow + 1, m_rows - 1); i++) {
+            for (int j = qMax(safeCol - 1, 0); j <= qMin(safeCol + 1, m_cols - 1); j++) {
+                safeCells[numSafe++] = i * m_cols + j;
+            }
+        }
+    }
+    // Safe cells are in ascending order, so each one at or below the
+    // mapped cell pushes it up by one
+    auto toBoardCell = [&](int cell) {
+        for (int i = 0; i < numSafe && safeCells[i] <= cell; i++) {
+            cell++;
+        }
+        return cell;
+    };
+
+    int numCells = m_rows * m_cols - numSafe;
+    for (int last = numCells - numMines; last < numCells; last++) {
+        int cell = toBoardCell(static_cast<int>(m_random.bounded(static_cast<quint64>(last) + 1)));
+        // If that cell is taken, the newly available cell can't be
+        if (hasMine(cell / m_cols, cell % m_cols)) {
+            cell = toBoardCell(last);
+        }
+        setMine(cell / m_cols, cell % m_cols);
+    }
+    calcMineCounts();
+}
+
+// Set a mine on a given cell
+void Board::setMine(int row, int col)
+{
+    if (isValidCell(row, col)) {
+        setBit(m_mines, cellIndex(row, col), true);
+    }
+}
+
+// Compute the number of surrounding mines for each cell
+//
+// Works on whole words at a time: the eight neighbor planes of a row are
+// built by shifting the mine planes of the rows above, below and itself,
+// then added with bit-sliced full adders, giving the counts of 64 cells
+// at once. The sentinel border has no mines, so the board's rows are one
+// straight pass over their words with no edge cases.
+void Board::calcMineCounts()
+{
+    if (m_mines.isEmpty()) {
+        return;
+    }
+
+    const quint64 *mines = m_mines.constData();
+    int firstWord = 1 + m_wordsPerRow;
+    int endWord = 1 + (m_rows + 1) * m_wordsPerRow;
+    for (int word = firstWord; word < endWord; word++) {
+        int above = word - m_wordsPerRow;
+        int below = word + m_wordsPerRow;
+
+        // Ones column: add the eight neighbor planes in groups of three
+        quint64 sumAbove, carryAbove;
+        fullAdd(westOf(mines, above), mines[above], eastOf(mines, above), sumAbove, carryAbove);
+        quint64 sumBelow, carryBelow;
+        fullAdd(westOf(mines, below), mines[below], eastOf(mines, below), sumBelow, carryBelow);
+        quint64 sumRows, carryRows;
+        fullAdd(sumAbove, sumBelow, westOf(mines, word), sumRows, carryRows);
+        quint64 east = eastOf(mines, word);
+        quint64 bit0 = sumRows ^ east;
+        quint64 carryEast = sumRows & east;
+
+        // Twos column: four carries from the ones column
+        quint64 sumTwos, carryTwos;
+        fullAdd(carryAbove, carryBelow, carryRows, sumTwos, carryTwos);
+        quint64 bit1 = sumTwos ^ carryEast;
+        quint64 carryFours = sumTwos & carryEast;
+
+        // Fours and eights columns
+        quint64 bit2 = carryTwos ^ carryFours;
+        quint64 bit3 = carryTwos & carryFours;
+
+        m_counts[0][word] = bit0;
+        m_counts[1][word] = bit1;
+        m_counts[2][word] = bit2;
+        m_counts[3][word] = bit3;
+    }
+}
+
+// Cells of a word that have no mine and no surrounding mines
+quint64 Board::zeroBits(int word) const
+{
+    return ~(m_mines[word] | m_counts[0][word] | m_counts[1][word]
+             | m_counts[2][word] | m_counts[3][word]) & validBits(word);
+}
+
+// Bits of a word that are board cells rather than sentinels or padding
+quint64 Board::validBits(int word) const
+{
+    int rowWord = word - 1;
+    if (rowWord < m_wordsPerRow || rowWord >= (m_rows + 1) * m_wordsPerRow) {
+        return 0;
+    }
+    // Column of bit 0 (the sentinel column is -1)
+    int firstCol = (rowWord % m_wordsPerRow) * 64 - 1;
+    int from = qMax(-firstCol, 0);
+    int to = qMin(m_cols - 1 - firstCol, 63);
+    return from <= to ? spanMask(from, to) : 0;
+}
+
+// Label the openings, if that hasn't been done since the mines last changed
+//
+// Runs of empty cells are found a word at a time, and runs that touch in
+// neighboring rows are joined with union-find. Large boards are split into
+// bands of rows labelled in parallel, then joined where bands meet.
+// Each run then adds the words covering it and its border to its opening,
+// grouped by opening with a counting sort.
+void Board::labelOpenings()
+{
+    if (m_openingsLabelled) {
+        return;
+    }
+    m_openingsLabelled = true;
+
+    // Find and join runs, one band of rows at a time
+    int numCells = m_rows * m_cols;
+    int numBands = numCells >= ParallelLabelCells ? qBound(1, QThread::idealThreadCount(), m_rows) : 1;
+    QVector<Band> bands(numBands);
+    for (int b = 0; b < numBands; b++) {
+        bands[b].firstRow = m_rows * b / numBands;
+        bands[b].lastRow = m_rows * (b + 1) / numBands - 1;
+    }
+    auto labelBand = [this](Band &band) {
+        for (int row = band.firstRow; row <= band.lastRow; row++) {
+            band.rowStart.append(band.runs.size());
+            int runStart = -1;
+            for (int w = 0; w < m_wordsPerRow; w++) {
+                int word = 1 + (row + 1) * m_wordsPerRow + w;
+                quint64 zeros = zeroBits(word);
+                for (int bit = 0; bit < 64; ) {
+                    // Skip to the next change between empty and non-empty cells
+                    quint64 rest = (runStart < 0 ? zeros : ~zeros) >> bit;
+                    if (!rest) {
+                        break;
+                    }
+                    bit += qCountTrailingZeroBits(rest);
+                    // Bit 0 of the row is the sentinel column
+                    int col = w * 64 + bit - 1;
+                    if (runStart < 0) {
+                        runStart = col;
+                    } else {
+                        Run run = { row, runStart, col - 1 };
+                        band.runs.append(run);
+                        band.parent.append(band.parent.size());
+                        runStart = -1;
+                    }
+                }
+            }
+            // The sentinel at the end of the row always ends the last run
+            if (row > band.firstRow) {
+                int previous = band.rowStart.size() - 2;
+                joinRows(band.parent, band.runs, band.rowStart[previous], band.rowStart[previous + 1], 0,
+                         band.runs, band.rowStart[previous + 1], band.runs.size(), 0);
+            }
+        }
+        band.rowStart.append(band.runs.size());
+    };
+    if (numBands > 1) {
+        QtConcurrent::blockingMap(bands, labelBand);
+    } else {
+        labelBand(bands[0]);
+    }
+
+    // Combine the bands and join them where they meet
+    QVector<int> bandOffset(numBands);
+    QVector<int> parent;
+    QVector<Run> runs;
+    for (int b = 0; b < numBands; b++) {
+        bandOffset[b] = runs.size();
+        for (int run : bands[b].parent) {
+            parent.append(bandOffset[b] + run);
+        }
+        runs += bands[b].runs;
+    }
+    for (int b = 1; b < numBands; b++) {
+        const Band &above = bands[b - 1];
+        const Band &below = bands[b];
+        int lastRowStart = above.rowStart[above.rowStart.size() - 2];
+        joinRows(parent, above.runs, lastRowStart, above.runs.size(), bandOffset[b - 1],
+                 below.runs, below.rowStart[0], below.rowStart[1], bandOffset[b]);
+    }
+
+    // Number the openings and label their cells
+    QVector<int> openingOfRun(runs.size());
+    int numOpenings = 0;
+    for (int run = 0; run < runs.size(); run++) {
+        int root = findRoot(parent, run);
+        openingOfRun[run] = root == run ? numOpenings++ : openingOfRun[root];
+    }
+    m_rowRuns.fill(0, m_rows + 1);
+    m_runs.resize(runs.size());
+    for (int run = 0; run < runs.size(); run++) {
+        m_rowRuns[runs[run].row + 1]++;
+        OpeningRun openingRun = { runs[run].left, runs[run].right, openingOfRun[run] };
+        m_runs[run] = openingRun;
+    }
+    for (int row = 0; row < m_rows; row++) {
+        m_rowRuns[row + 1] += m_rowRuns[row];
+    }
+
+    // Words covering each run and its border, grouped by opening. The
+    // border may take in sentinels, which are cleared so never revealed.
+    m_openingStart.fill(0, numOpenings + 1);
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            // Turn the counts into start positions
+            for (int opening = 1; opening <= numOpenings; opening++) {
+                m_openingStart[opening] += m_openingStart[opening - 1];
+            }
+            m_openingWords.resize(m_openingStart[numOpenings]);
+            m_openingMasks.resize(m_openingStart[numOpenings]);
+        }
+        QVector<int> next = pass == 1 ? m_openingStart : QVector<int>();
+        for (int run = 0; run < runs.size(); run++) {
+            int opening = openingOfRun[run];
+            // Bits of the row covering the run and the cells either side
+            int left = runs[run].left;
+            int right = runs[run].right + 2;
+            for (int row = runs[run].row - 1; row <= runs[run].row + 1; row++) {
+                for (int w = left / 64; w <= right / 64; w++) {
+                    if (pass == 0) {
+                        m_openingStart[opening + 1]++;
+                        continue;
+                    }
+                    int entry = next[opening]++;
+                    m_openingWords[entry] = 1 + (row + 1) * m_wordsPerRow + w;
+                    m_openingMasks[entry] = spanMask(qMax(left, w * 64) - w * 64,
+                                                     qMin(right, w * 64 + 63) - w * 64);
+                }
+            }
+        }
+    }
+
+    // 3BV: each opening, plus each safe cell no opening reveals
+    QVector<quint64> covered(m_mines.size(), 0);
+    for (int i = 0; i < m_openingWords.size(); i++) {
+        covered[m_openingWords[i]] |= m_openingMasks[i];
+    }
+    m_threeBV = numOpenings;
+    for (int word = 0; word < m_mines.size(); word++) {
+        m_threeBV += qPopulationCount(~(covered[word] | m_mines[word]) & validBits(word));
+    }
+}
+
+// Store a cell's count in the bit-sliced count planes
+void Board::setMineCount(int index, int count)
+{
+    for (int plane = 0; plane < NumCountPlanes; plane++) {
+        setBit(m_counts[plane], index, (count >> plane) & 1);
+    }
+}
+
+// Set or clear a cell's bit in a bit-plane
+void Board::setBit(QVector<quint64> &plane, int index, bool value)
+{
+    quint64 mask = quint64(1) << (index % 64);
+    quint64 &word = plane[index / 64];
+    if (value) {
+        word |= mask;
+    } else {
+        word &= ~mask;
+    }
+}
+
+// Are the given cell coordinates valid?
+bool Board::isValidCell(int row, int col)
+{
+    // Make sure board has been allocated
+    if (m_mines.isEmpty()) {
+        return false;
+    }
+    // Make sure row and col are within bounds
+    if (row < 0 || row >= m_rows) {
+        return false;
+    }
+    if (col < 0 || col >= m_cols) {
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,191 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "Random.h"
+#include "RevealDelta.h"
+#include <QString>
+#include <QVector>
+#include <QtAlgorithms>
+
+// Internal representation of the Minesweeper board
+//
+// Cell state is stored as bit-planes: one bit per cell, packed into
+// 64-bit words, with each row starting on a new word. Mine counts are
+// stored bit-sliced in four more planes (bit n of a cell's count is in
+// plane n), so a cell costs 7 bits instead of a full struct. Nothing
+// else is kept per cell.
+//
+// The planes have a one-cell border of sentinel cells around the board,
+// which have no mines and are marked cleared, so loops that stop at
+// cleared cells stop at the edge too. Inside the board, cells are
+// addressed by an index into the planes, and the eight neighbors of a
+// cell are at fixed offsets from it, so neighbor loops need no bounds
+// checks. The public row/column functions still check their arguments.
+//
+// Openings (connected regions of cells with no surrounding mines) are
+// labelled once per board, the first time they are needed. Each opening
+// keeps the bit-plane words covering it and its border, so revealing it
+// is one OR per word. The labelling also gives the board's 3BV. A cell's
+// opening is found from the runs of empty cells in its row, so the
+// labelling costs memory per run rather than per cell.
+//
+// The flagged and cleared neighbors of a cell are counted from the
+// planes, three words read and masked per plane, so chord and frontier
+// checks need no per-cell counters kept up to date.
+//
+// Board is a plain value with no QObject state, so that game engines
+// can own and copy boards on any thread.
+//
+// A board's whole state can be saved as a snapshot file holding the
+// mine, flag and cleared planes as they are laid out in memory, each
+// starting on a page. The file is memory-mapped: loading copies each
+// plane out in one block, with no parsing, then works out the counts
+// from the mines, and saving rewrites only the pages that changed.
+
+class Board
+{
+public:
+    Board();
+    void initialize(int rows, int cols, int numMines, quint64 seed,
+                    int safeRow = -1, int safeCol = -1);
+    int rows() const;
+    int cols() const;
+    int numMines() const;
+    bool hasMine(int row, int col);
+    int mineCount(int row, int col);
+    void toggleFlag(int row, int col);
+    void clearCell(int row, int col);
+    bool isFlagged(int row, int col);
+    bool isCleared(int row, int col);
+    bool mineTriggered();
+    bool allCellsCleared();
+    int numSurroundingFlags(int row, int col);
+    int numSurroundingCleared(int row, int col);
+    void moveMine(int fromRow, int fromCol, int toRow, int toCol);
+    int openingAt(int row, int col);
+    bool openingHasFlags(int opening);
+    void revealOpening(int opening, RevealDelta &revealed);
+    int numOpenings();
+    int threeBV();
+    static bool isValidSize(quint64 rows, quint64 cols);
+    bool saveSnapshot(const QString &path) const;
+    bool loadSnapshot(const QString &path);
+
+    // Unchecked versions for tight loops, by cell index. The index must be
+    // of a board cell or, for reads, a sentinel cell next to one.
+    static const int NumNeighbors = 8;
+    int cellIndex(int row, int col) const { return (row + 1) * m_stride + col + 1 + 64; }
+    int rowOf(int index) const { return (index - 64) / m_stride - 1; }
+    int colOf(int index) const { return (index - 64) % m_stride - 1; }
+    int rowStride() const { return m_stride; }
+    int numCellIndexes() const { return m_mines.size() * 64; }
+    const int *neighborOffsets() const { return m_neighborOffsets; }
+    bool mineAt(int index) const { return testBit(m_mines, index); }
+    bool flaggedAt(int index) const { return testBit(m_flags, index); }
+    bool clearedAt(int index) const { return testBit(m_cleared, index); }
+    bool zeroCountAt(int index) const;
+    int countAt(int index) const;
+    int surroundingFlagsAt(int index) const { return countAround(m_flags, index); }
+    int surroundingClearedAt(int index) const;
+    void clearCellAt(int index);
+
+private:
+    void setSize(int rows, int cols);
+    bool isValidCell(int row, int col);
+    void setMines(int numMines, int safeRow, int safeCol);
+    void setMine(int row, int col);
+    void calcMineCounts();
+    void setMineCount(int index, int count);
+    quint64 zeroBits(int word) const;
+    quint64 validBits(int word) const;
+    void labelOpenings();
+    bool isConsistent() const;
+    bool testBit(const QVector<quint64> &plane, int index) const;
+    int countInRow(const quint64 *plane, int index) const;
+    int countAround(const QVector<quint64> &plane, int index) const;
+    void setBit(QVector<quint64> &plane, int index, bool value);
+
+private:
+    // A run of empty cells in a row, and the opening it belongs to
+    struct OpeningRun
+    {
+        int left;
+        int right;
+        int opening;
+    };
+
+    static const int NumCountPlanes = 4;
+    QVector<quint64> m_mines;
+    QVector<quint64> m_flags;
+    QVector<quint64> m_cleared;
+    QVector<quint64> m_counts[NumCountPlanes];
+    Random m_random;
+    int m_rows;
+    int m_cols;
+    int m_wordsPerRow;
+    // Cell indexes per row, and from a cell to each of its neighbors.
+    // Index 0 is the first bit of the guard word before the sentinel row,
+    // so cell (row, col) is at 64 + (row + 1) * m_stride + col + 1.
+    int m_stride;
+    int m_neighborOffsets[NumNeighbors];
+    int m_numMines;
+    int m_numLeftToClear;
+    bool m_mineTriggered;
+    // Runs of empty cells in row and column order, those of row r being
+    // m_runs[m_rowRuns[r] .. m_rowRuns[r + 1] - 1]. Opening n covers the
+    // words m_openingWords[m_openingStart[n] .. m_openingStart[n + 1] - 1],
+    // with m_openingMasks giving its cells in each word.
+    bool m_openingsLabelled;
+    QVector<int> m_rowRuns;
+    QVector<OpeningRun> m_runs;
+    QVector<int> m_openingStart;
+    QVector<int> m_openingWords;
+    QVector<quint64> m_openingMasks;
+    int m_threeBV;
+};
+
+// Read a cell's bit from a bit-plane
+inline bool Board::testBit(const QVector<quint64> &plane, int index) const
+{
+    return (plane[index / 64] >> (index % 64)) & 1;
+}
+
+// Number of a cell and its west and east neighbors set in a bit-plane
+inline int Board::countInRow(const quint64 *plane, int index) const
+{
+    unsigned first = static_cast<unsigned>(index - 1);
+    unsigned bit = first % 64;
+    const quint64 *word = plane + first / 64;
+    // The second word only matters when the three bits straddle two words
+    quint64 bits = (word[0] >> bit) | ((word[1] << 1) << (63 - bit));
+    // Population counts of 0..7, four bits each
+    return (0x32212110 >> ((bits & 7) * 4)) & 0xf;
+}
+
+// Number of a cell's eight neighbors set in a bit-plane
+inline int Board::countAround(const QVector<quint64> &plane, int index) const
+{
+    const quint64 *words = plane.constData();
+    int centre = static_cast<int>((words[static_cast<unsigned>(index) / 64] >> (index % 64)) & 1);
+    return countInRow(words, index - m_stride) + countInRow(words, index) - centre
+            + countInRow(words, index + m_stride);
+}
+
+// Does a cell have no mines around it?
+inline bool Board::zeroCountAt(int index) const
+{
+    int word = index / 64;
+    quint64 bits = m_counts[0][word] | m_counts[1][word] | m_counts[2][word] | m_counts[3][word];
+    return !((bits >> (index % 64)) & 1);
+}
+
+// Reassemble a cell's count from its bit-sliced planes
+inline int Board::countAt(int index) const
+{
+    int word = index / 64;
+    int bit = index % 64;
+    return static_cast<int>(((m_counts[0][word] >> bit) & 1) | (((m_counts[1][word] >> bit) & 1) << 1)
+                            | (((m_counts[2][word] >> bit) & 1) << 2) | (((m_counts[3][word] >> bit) & 1) << 3));
+}
+
+#endif // BOARD_H
@@ -0,0 +1,146 @@
+#include "BoardPool.h"
+#include <QRandomGenerator>
+#include <QtConcurrent>
+
+bool BoardPool::Config::operator==(const Config &other) const
+{
+    return rows == other.rows && cols == other.cols && mines == other.mines
+            && noGuess == other.noGuess;
+}
+
+BoardPool::BoardPool(int capacity)
+{
+    m_capacity = qMax(1, capacity);
+    m_producing = false;
+    m_stopping.storeRelease(0);
+    // One producer at a time; no-guess generation has its own workers
+    m_producerThread.setMaxThreadCount(1);
+}
+
+// Stop the producer, cutting short any no-guess board it is generating
+BoardPool::~BoardPool()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping.storeRelease(1);
+    }
+    m_producer.waitForFinished();
+}
+
+// Start keeping boards for a configuration before they are needed
+void BoardPool::prepare(const Config &config)
+{
+    QMutexLocker locker(&m_mutex);
+    touchShelf(config);
+    startProducer();
+}
+
+// Take a finished board for a configuration. Returns false if none is
+// ready yet; the pool starts filling up for next time either way.
+bool BoardPool::take(const Config &config, Entry &entry)
+{
+    QMutexLocker locker(&m_mutex);
+    touchShelf(config);
+    Shelf &shelf = m_shelves.first();
+    bool found = !shelf.boards.isEmpty();
+    if (found) {
+        entry = shelf.boards.dequeue();
+    }
+    startProducer();
+    return found;
+}
+
+// Move a configuration's shelf to the front, adding it if needed and
+// dropping the least recently used one if there are too many.
+// Called with the mutex held.
+void BoardPool::touchShelf(const Config &config)
+{
+    for (int i = 0; i < m_shelves.size(); i++) {
+        if (m_shelves[i].config == config) {
+            if (i > 0) {
+                Shelf shelf = m_shelves.takeAt(i);
+                m_shelves.prepend(shelf);
+            }
+            return;
+        }
+    }
+    Shelf shelf;
+    shelf.config = config;
+    shelf.failed = false;
+    m_shelves.prepend(shelf);
+    if (m_shelves.size() > MaxShelves) {
+        m_shelves.removeLast();
+    }
+}
+
+// Find the most recently used configuration that isn't full and can
+// still be filled. Called with the mutex held.
+bool BoardPool::nextToFill(Config &config)
+{
+    for (const Shelf &shelf : m_shelves) {
+        if (!shelf.failed && shelf.boards.size() < m_capacity) {
+            config = shelf.config;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Start the producer if it isn't running. Called with the mutex held.
+void BoardPool::startProducer()
+{
+    if (m_producing || m_stopping.loadAcquire()) {
+        return;
+    }
+    m_producing = true;
+    m_producer = QtConcurrent::run(&m_producerThread, [this]() { produce(); });
+}
+
+// Generate boards until every shelf is full
+void BoardPool::produce()
+{
+    while (true) {
+        Config config;
+        {
+            QMutexLocker locker(&m_mutex);
+            if (m_stopping.loadAcquire() || !nextToFill(config)) {
+                m_producing = false;
+                return;
+            }
+        }
+
+        Entry entry;
+        entry.seed = QRandomGenerator::global()->generate64();
+        if (config.noGuess) {
+            int row = config.rows / 2;
+            int col = config.cols / 2;
+            if (!m_generator.generate(config.rows, config.cols, config.mines, row, col,
+                                      entry.seed, entry.board, &m_stopping)) {
+                QMutexLocker locker(&m_mutex);
+                if (m_stopping.loadAcquire()) {
+                    m_producing = false;
+                    return;
+                }
+                // Too dense to avoid guessing; leave the engine thread to
+                // try for the first click, and report it if that fails too
+                for (Shelf &shelf : m_shelves) {
+                    if (shelf.config == config) {
+                        shelf.failed = true;
+                    }
+                }
+                continue;
+            }
+        } else {
+            entry.board.initialize(config.rows, config.cols, config.mines, entry.seed);
+        }
+
+        // The configuration may have been dropped while generating
+        QMutexLocker locker(&m_mutex);
+        for (Shelf &shelf : m_shelves) {
+            if (shelf.config == config && shelf.boards.size() < m_capacity) {
+                shelf.boards.enqueue(entry);
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef BOARDPOOL_H
+#define BOARDPOOL_H
+
+#include "Board.h"
+#include "NoGuessGenerator.h"
+#include <QAtomicInt>
+#include <QFuture>
+#include <QMutex>
+#include <QQueue>
+#include <QThreadPool>
+#include <QVector>
+
+// Keeps a few ready-made boards for recently used board configurations
+//
+// A producer on a background thread fills the pool, so starting a game
+// only has to take a finished board off a queue. Boards share their data
+// implicitly, so taking one is O(1) whatever its size.
+//
+// Each board is tagged with the seed it was generated from. No-guess
+// boards are generated for a first click in the centre of the board. If
+// one can't be generated, its configuration is given up on, so that
+// only boards that really are no-guess are ever handed out.
+
+class BoardPool
+{
+public:
+    struct Config {
+        int rows;
+        int cols;
+        int mines;
+        bool noGuess;
+        bool operator==(const Config &other) const;
+    };
+
+    struct Entry {
+        quint64 seed;
+        Board board;
+    };
+
+    explicit BoardPool(int capacity);
+    ~BoardPool();
+    void prepare(const Config &config);
+    bool take(const Config &config, Entry &entry);
+
+private:
+    // Boards for one configuration
+    struct Shelf {
+        Config config;
+        QQueue<Entry> boards;
+        // Set when a no-guess board couldn't be generated
+        bool failed;
+    };
+
+    void touchShelf(const Config &config);
+    bool nextToFill(Config &config);
+    void startProducer();
+    void produce();
+
+private:
+    // Configurations kept, most recently used first
+    static const int MaxShelves = 6;
+    int m_capacity;
+    QMutex m_mutex;
+    QVector<Shelf> m_shelves;
+    bool m_producing;
+    // Set when the pool is destroyed; also stops no-guess generation
+    QAtomicInt m_stopping;
+    QThreadPool m_producerThread;
+    QFuture<void> m_producer;
+    NoGuessGenerator m_generator;
+};
+
+#endif // BOARDPOOL_H
@@ -0,0 +1,742 @@
+#include "ChunkedBoard.h"
+#include <QtAlgorithms>
+#include <QtMath>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Splits with at most this many mines (or empty cells) are drawn exactly,
+// one mine at a time; larger ones use the normal approximation
+const qint64 ExactSplitLimit = 256;
+
+// Words of a touched chunk's state
+const int FlagsPlane = 0;
+const int ClearedPlane = 1;
+const int FirstCountPlane = 2;
+const int NumCountPlanes = 4;
+const int NumStatePlanes = FirstCountPlane + NumCountPlanes;
+const int CellsPerChunk = ChunkedBoard::ChunkSize * ChunkedBoard::ChunkSize;
+
+// Mixed into the seed of endless boards, so they don't share streams with
+// the splits of bounded ones
+const quint64 EndlessSalt = 0x6a09e667f3bcc908ULL;
+
+// Lowest mine density of an endless board. Below about 10% its empty
+// cells join up into openings that go on forever.
+const double MinEndlessDensity = 0.15;
+
+quint64 chunkKey(int chunkRow, int chunkCol)
+{
+    return (quint64(quint32(chunkRow)) << 32) | quint32(chunkCol);
+}
+
+// Chunk holding a row or column, rounding down for negative ones
+inline int chunkOf(int index)
+{
+    return index >> 6;
+}
+
+// Position of a row or column within its chunk
+inline int offsetIn(int index)
+{
+    return index & (ChunkedBoard::ChunkSize - 1);
+}
+
+// Seed of the random stream for one split of the mine total
+quint64 mixSeed(quint64 seed, quint64 first, quint64 end)
+{
+    quint64 z = seed ^ (first * 0x9e3779b97f4a7c15ULL) ^ (end * 0xc2b2ae3d27d4eb4fULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Number of mines among the first n of numCells cells, when numMines of
+// them are mines (a hypergeometric draw)
+qint64 splitMines(Random &random, qint64 numCells, qint64 numMines, qint64 n)
+{
+    qint64 low = qMax<qint64>(0, numMines - (numCells - n));
+    qint64 high = qMin(numMines, n);
+    if (low == high) {
+        return low;
+    }
+
+    // Few mines, or few empty cells: place them one at a time
+    qint64 fewer = qMin(numMines, numCells - numMines);
+    if (fewer <= ExactSplitLimit) {
+        qint64 inFirst = 0;
+        qint64 firstLeft = n;
+        qint64 cellsLeft = numCells;
+        for (qint64 i = 0; i < fewer; i++) {
+            if (static_cast<qint64>(random.bounded(static_cast<quint64>(cellsLeft))) < firstLeft) {
+                inFirst++;
+                firstLeft--;
+            }
+            cellsLeft--;
+        }
+        return numMines <= numCells - numMines ? inFirst : n - inFirst;
+    }
+
+    // Otherwise the normal approximation is very close (Box-Muller)
+    double p = double(numMines) / numCells;
+    double mean = n * p;
+    double variance = n * p * (1 - p) * double(numCells - n) / double(numCells - 1);
+    double u1 = (random.next() >> 11) * (1.0 / 9007199254740992.0);
+    double u2 = (random.next() >> 11) * (1.0 / 9007199254740992.0);
+    double gaussian = qSqrt(-2 * qLn(1 - u1)) * qCos(2 * M_PI * u2);
+    return qBound(low, qRound64(mean + qSqrt(variance) * gaussian), high);
+}
+
+// Add three one-bit planes, giving a sum bit and a carry bit per cell
+inline void fullAdd(quint64 a, quint64 b, quint64 c, quint64 &sum, quint64 &carry)
+{
+    quint64 ab = a ^ b;
+    sum = ab ^ c;
+    carry = (a & b) | (ab & c);
+}
+
+}
+
+const int ChunkedBoard::ChunkSize;
+const int ChunkedBoard::DefaultChunkLimit;
+
+ChunkedBoard::ChunkedBoard()
+{
+    m_lastKey = 0;
+    m_lastChunk = nullptr;
+    m_useCount = 0;
+    m_chunkLimit = DefaultChunkLimit;
+    m_endless = false;
+    m_mineThreshold = 0;
+    m_rows = 0;
+    m_cols = 0;
+    m_chunkRows = 0;
+    m_chunkCols = 0;
+    m_numMines = 0;
+    m_numLeftToClear = 0;
+    m_seed = 0;
+    m_mineTriggered = false;
+}
+
+// Set up a board with given dimensions and number of mines. No chunks are
+// created until they are used. If a safe cell is given, no mines are
+// placed on it or its neighbors.
+void ChunkedBoard::initialize(int rows, int cols, qint64 numMines, quint64 seed, int safeRow, int safeCol)
+{
+    m_chunks.clear();
+    m_savedChunks.clear();
+    m_lastChunk = nullptr;
+    m_endless = false;
+    m_rows = qMax(rows, 0);
+    m_cols = qMax(cols, 0);
+    m_chunkRows = (m_rows + ChunkSize - 1) / ChunkSize;
+    m_chunkCols = (m_cols + ChunkSize - 1) / ChunkSize;
+    m_seed = seed;
+
+    m_safeCells.clear();
+    if (isValidCell(safeRow, safeCol)) {
+        for (int i = qMax(safeRow - 1, 0); i <= qMin(safeRow + 1, m_rows - 1); i++) {
+            for (int j = qMax(safeCol - 1, 0); j <= qMin(safeCol + 1, m_cols - 1); j++) {
+                m_safeCells.append(qMakePair(i, j));
+            }
+        }
+    }
+
+    qint64 numCells = qint64(m_rows) * m_cols;
+    m_numMines = qBound<qint64>(0, numMines, numCells - m_safeCells.size());
+    m_numLeftToClear = numCells - m_numMines;
+    m_mineTriggered = false;
+}
+
+// Set up an endless board, where each cell is a mine with the given
+// probability (at least MinEndlessDensity). The cell given and its
+// neighbors are kept clear of mines.
+void ChunkedBoard::initializeEndless(double mineDensity, quint64 seed, int safeRow, int safeCol)
+{
+    m_chunks.clear();
+    m_savedChunks.clear();
+    m_lastChunk = nullptr;
+    m_endless = true;
+    m_rows = 0;
+    m_cols = 0;
+    m_chunkRows = 0;
+    m_chunkCols = 0;
+    m_seed = seed;
+
+    m_safeCells.clear();
+    for (int i = safeRow - 1; i <= safeRow + 1; i++) {
+        for (int j = safeCol - 1; j <= safeCol + 1; j++) {
+            m_safeCells.append(qMakePair(i, j));
+        }
+    }
+
+    double density = qBound(MinEndlessDensity, mineDensity, 1.0);
+    m_mineThreshold = density < 1 ? quint64(density * 18446744073709551616.0) : ~quint64(0);
+    m_numMines = 0;
+    m_numLeftToClear = std::numeric_limits<qint64>::max();
+    m_mineTriggered = false;
+}
+
+// Does the board go on forever?
+bool ChunkedBoard::isEndless() const
+{
+    return m_endless;
+}
+
+int ChunkedBoard::rows() const
+{
+    return m_rows;
+}
+
+int ChunkedBoard::cols() const
+{
+    return m_cols;
+}
+
+// Number of mines on the whole board; endless boards don't have one
+qint64 ChunkedBoard::numMines() const
+{
+    return m_numMines;
+}
+
+// Are the given cell coordinates valid?
+bool ChunkedBoard::isValidCell(int row, int col) const
+{
+    return m_endless || (row >= 0 && row < m_rows && col >= 0 && col < m_cols);
+}
+
+// Does a given cell contain a mine?
+bool ChunkedBoard::hasMine(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return false;
+    }
+    const Chunk &cells = chunk(chunkOf(row), chunkOf(col));
+    return (cells.mines[offsetIn(row)] >> offsetIn(col)) & 1;
+}
+
+// Return the number of neighboring cells that contain mines
+int ChunkedBoard::mineCount(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return 0;
+    }
+    const Chunk &cells = touchedChunk(chunkOf(row), chunkOf(col));
+    int count = 0;
+    for (int plane = 0; plane < NumCountPlanes; plane++) {
+        quint64 word = cells.state[(FirstCountPlane + plane) * ChunkSize + offsetIn(row)];
+        count |= int((word >> offsetIn(col)) & 1) << plane;
+    }
+    return count;
+}
+
+// Toggle the flag marking for a cell
+void ChunkedBoard::toggleFlag(int row, int col)
+{
+    if (isValidCell(row, col)) {
+        Chunk &cells = touchedChunk(chunkOf(row), chunkOf(col));
+        cells.state[FlagsPlane * ChunkSize + offsetIn(row)] ^= quint64(1) << offsetIn(col);
+    }
+}
+
+// Clear a cell, revealing a mine or count
+void ChunkedBoard::clearCell(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return;
+    }
+    Chunk &cells = touchedChunk(chunkOf(row), chunkOf(col));
+    quint64 &cleared = cells.state[ClearedPlane * ChunkSize + offsetIn(row)];
+    quint64 bit = quint64(1) << offsetIn(col);
+    if (cleared & bit) {
+        return;
+    }
+    cleared |= bit;
+    if (cells.mines[offsetIn(row)] & bit) {
+        m_mineTriggered = true;
+    } else {
+        m_numLeftToClear--;
+    }
+}
+
+// Is this cell flagged? Cells in untouched chunks never are.
+bool ChunkedBoard::isFlagged(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return false;
+    }
+    const Chunk *cells = stateChunk(chunkOf(row), chunkOf(col));
+    if (!cells) {
+        return false;
+    }
+    return (cells->state[FlagsPlane * ChunkSize + offsetIn(row)] >> offsetIn(col)) & 1;
+}
+
+// Has this cell been cleared? Cells in untouched chunks never have.
+bool ChunkedBoard::isCleared(int row, int col)
+{
+    if (!isValidCell(row, col)) {
+        return false;
+    }
+    const Chunk *cells = stateChunk(chunkOf(row), chunkOf(col));
+    if (!cells) {
+        return false;
+    }
+    return (cells->state[ClearedPlane * ChunkSize + offsetIn(row)] >> offsetIn(col)) & 1;
+}
+
+// Has a mine been triggered?
+bool ChunkedBoard::mineTriggered() const
+{
+    return m_mineTriggered;
+}
+
+// Have all cells been cleared?
+bool ChunkedBoard::allCellsCleared() const
+{
+    return m_numLeftToClear <= 0;
+}
+
+// Return the number of surrounding cells that have been flagged
+int ChunkedBoard::numSurroundingFlags(int row, int col)
+{
+    int numFlags = 0;
+    for (int i = row - 1; i <= row + 1; i++) {
+        for (int j = col - 1; j <= col + 1; j++) {
+            if (!(i == row && j == col) && isFlagged(i, j)) {
+                numFlags++;
+            }
+        }
+    }
+    return numFlags;
+}
+
+// Number of chunks held in memory, touched or not
+int ChunkedBoard::numChunks() const
+{
+    return m_chunks.size();
+}
+
+// Chunks that have been touched, as (chunk row, chunk column): those in
+// memory, and those evicted with changes the player made to them
+QVector<QPair<int, int>> ChunkedBoard::touchedChunks() const
+{
+    QVector<QPair<int, int>> touched;
+    for (auto it = m_chunks.constBegin(); it != m_chunks.constEnd(); ++it) {
+        if (!it.value().state.isEmpty()) {
+            touched.append(qMakePair(int(quint32(it.key() >> 32)), int(quint32(it.key()))));
+        }
+    }
+    for (auto it = m_savedChunks.constBegin(); it != m_savedChunks.constEnd(); ++it) {
+        touched.append(qMakePair(int(quint32(it.key() >> 32)), int(quint32(it.key()))));
+    }
+    return touched;
+}
+
+// Keep at most this many chunks in memory (no limit if not positive).
+// Should be well above the nine a count needs.
+void ChunkedBoard::setChunkLimit(int chunks)
+{
+    m_chunkLimit = chunks;
+}
+
+// Number of evicted chunks the player had changed
+int ChunkedBoard::numSavedChunks() const
+{
+    return m_savedChunks.size();
+}
+
+// Rows in a chunk row; the last may be partly off the board
+int ChunkedBoard::chunkHeight(int chunkRow) const
+{
+    if (m_endless) {
+        return ChunkSize;
+    }
+    return qMin(ChunkSize, m_rows - chunkRow * ChunkSize);
+}
+
+// Columns in a chunk column; the last may be partly off the board
+int ChunkedBoard::chunkWidth(int chunkCol) const
+{
+    if (m_endless) {
+        return ChunkSize;
+    }
+    return qMin(ChunkSize, m_cols - chunkCol * ChunkSize);
+}
+
+// Number of cells that can hold mines in the chunks before a chunk,
+// taking chunks in row order
+qint64 ChunkedBoard::cellsBefore(qint64 chunkIndex) const
+{
+    qint64 chunkRow = chunkIndex / m_chunkCols;
+    qint64 chunkCol = chunkIndex % m_chunkCols;
+    qint64 cells = qMin<qint64>(chunkRow * ChunkSize, m_rows) * m_cols;
+    if (chunkRow < m_chunkRows) {
+        cells += qint64(chunkHeight(int(chunkRow))) * qMin<qint64>(chunkCol * ChunkSize, m_cols);
+    }
+    for (const QPair<int, int> &cell : m_safeCells) {
+        if (qint64(chunkOf(cell.first)) * m_chunkCols + chunkOf(cell.second) < chunkIndex) {
+            cells--;
+        }
+    }
+    return cells;
+}
+
+// Share of the board's mines that fall in a chunk. The mine total is
+// split between halves of the range of chunks containing this one until
+// only this chunk is left; each split is seeded by its range, so every
+// chunk sees the same splits above it.
+qint64 ChunkedBoard::minesInChunk(qint64 chunkIndex) const
+{
+    qint64 first = 0;
+    qint64 end = qint64(m_chunkRows) * m_chunkCols;
+    qint64 numMines = m_numMines;
+    while (end - first > 1) {
+        qint64 middle = first + (end - first) / 2;
+        qint64 firstCell = cellsBefore(first);
+        qint64 numCells = cellsBefore(end) - firstCell;
+        qint64 numFirstHalf = cellsBefore(middle) - firstCell;
+        Random random(mixSeed(m_seed, quint64(first), quint64(end)));
+        qint64 firstHalfMines = splitMines(random, numCells, numMines, numFirstHalf);
+        if (chunkIndex < middle) {
+            end = middle;
+            numMines = firstHalfMines;
+        } else {
+            first = middle;
+            numMines -= firstHalfMines;
+        }
+    }
+    return numMines;
+}
+
+// The chunk at a chunk position if it is in memory, or nullptr
+ChunkedBoard::Chunk *ChunkedBoard::findChunk(int chunkRow, int chunkCol)
+{
+    quint64 key = chunkKey(chunkRow, chunkCol);
+    if (!m_lastChunk || m_lastKey != key) {
+        auto it = m_chunks.find(key);
+        if (it == m_chunks.end()) {
+            return nullptr;
+        }
+        m_lastKey = key;
+        m_lastChunk = &it.value();
+    }
+    m_lastChunk->lastUsed = ++m_useCount;
+    return m_lastChunk;
+}
+
+// The chunk at a chunk position, creating it with its mines if needed. A
+// chunk that was evicted gets back the changes the player made to it.
+ChunkedBoard::Chunk &ChunkedBoard::chunk(int chunkRow, int chunkCol)
+{
+    Chunk *cells = findChunk(chunkRow, chunkCol);
+    if (!cells) {
+        evictChunks();
+        quint64 key = chunkKey(chunkRow, chunkCol);
+        cells = &m_chunks[key];
+        generateMines(*cells, chunkRow, chunkCol);
+        cells->lastUsed = ++m_useCount;
+        m_lastKey = key;
+        m_lastChunk = cells;
+
+        auto saved = m_savedChunks.find(key);
+        if (saved != m_savedChunks.end()) {
+            allocateState(*cells, chunkRow, chunkCol);
+            restoreChunk(*cells, saved.value());
+            m_savedChunks.erase(saved);
+        }
+    }
+    return *cells;
+}
+
+// The chunk at a chunk position, with its flags, cleared cells and counts
+ChunkedBoard::Chunk &ChunkedBoard::touchedChunk(int chunkRow, int chunkCol)
+{
+    Chunk &cells = chunk(chunkRow, chunkCol);
+    if (cells.state.isEmpty()) {
+        allocateState(cells, chunkRow, chunkCol);
+    }
+    return cells;
+}
+
+// The chunk at a chunk position if the player has changed anything in
+// it, or nullptr. Untouched chunks aren't created.
+ChunkedBoard::Chunk *ChunkedBoard::stateChunk(int chunkRow, int chunkCol)
+{
+    Chunk *cells = findChunk(chunkRow, chunkCol);
+    if (!cells && m_savedChunks.contains(chunkKey(chunkRow, chunkCol))) {
+        cells = &chunk(chunkRow, chunkCol);
+    }
+    if (!cells || cells->state.isEmpty()) {
+        return nullptr;
+    }
+    return cells;
+}
+
+// Give a chunk its flags, cleared cells and counts
+void ChunkedBoard::allocateState(Chunk &chunk, int chunkRow, int chunkCol)
+{
+    chunk.state.fill(0, NumStatePlanes * ChunkSize);
+    // Cells past the edge of the board count as cleared
+    for (int row = 0; row < ChunkSize; row++) {
+        chunk.state[ClearedPlane * ChunkSize + row] = offBoardBits(chunkRow, chunkCol, row);
+    }
+    calcMineCounts(chunk, chunkRow, chunkCol);
+}
+
+// Cells of a chunk row that are past the edge of the board
+quint64 ChunkedBoard::offBoardBits(int chunkRow, int chunkCol, int row) const
+{
+    if (row >= chunkHeight(chunkRow)) {
+        return ~quint64(0);
+    }
+    int width = chunkWidth(chunkCol);
+    return width < ChunkSize ? ~quint64(0) << width : 0;
+}
+
+// Place a chunk's share of the mines with Floyd's sampling, as
+// Board::setMines() does over the whole board
+void ChunkedBoard::generateMines(Chunk &chunk, int chunkRow, int chunkCol) const
+{
+    for (int row = 0; row < ChunkSize; row++) {
+        chunk.mines[row] = 0;
+    }
+    if (m_endless) {
+        generateEndlessMines(chunk, chunkRow, chunkCol);
+        return;
+    }
+    qint64 chunkIndex = qint64(chunkRow) * m_chunkCols + chunkCol;
+    chunk.numMines = minesInChunk(chunkIndex);
+    if (chunk.numMines == 0) {
+        return;
+    }
+
+    // Safe cells in this chunk, numbered within it, in ascending order
+    int width = chunkWidth(chunkCol);
+    int safeCells[9];
+    int numSafe = 0;
+    for (const QPair<int, int> &cell : m_safeCells) {
+        if (chunkOf(cell.first) == chunkRow && chunkOf(cell.second) == chunkCol) {
+            safeCells[numSafe++] = offsetIn(cell.first) * width + offsetIn(cell.second);
+        }
+    }
+    auto toChunkCell = [&](int cell) {
+        for (int i = 0; i < numSafe && safeCells[i] <= cell; i++) {
+            cell++;
+        }
+        return cell;
+    };
+    auto taken = [&](int cell) {
+        return (chunk.mines[cell / width] >> (cell % width)) & 1;
+    };
+
+    Random random(mixSeed(m_seed, quint64(chunkIndex), quint64(chunkIndex) + 1));
+    int numCells = chunkHeight(chunkRow) * width - numSafe;
+    for (int last = numCells - int(chunk.numMines); last < numCells; last++) {
+        int cell = toChunkCell(static_cast<int>(random.bounded(static_cast<quint64>(last) + 1)));
+        // If that cell is taken, the newly available cell can't be
+        if (taken(cell)) {
+            cell = toChunkCell(last);
+        }
+        chunk.mines[cell / width] |= quint64(1) << (cell % width);
+    }
+}
+
+// Decide each cell of an endless board's chunk on its own: it is a mine
+// when the hash of the seed and its coordinates is below the threshold
+void ChunkedBoard::generateEndlessMines(Chunk &chunk, int chunkRow, int chunkCol) const
+{
+    quint64 seed = m_seed ^ EndlessSalt;
+    int firstRow = chunkRow * ChunkSize;
+    int firstCol = chunkCol * ChunkSize;
+    chunk.numMines = 0;
+    for (int row = 0; row < ChunkSize; row++) {
+        quint64 word = 0;
+        for (int col = 0; col < ChunkSize; col++) {
+            quint64 hash = mixSeed(seed, quint32(firstRow + row), quint32(firstCol + col));
+            word |= quint64(hash < m_mineThreshold) << col;
+        }
+        for (const QPair<int, int> &cell : m_safeCells) {
+            if (cell.first == firstRow + row && chunkOf(cell.second) == chunkCol) {
+                word &= ~(quint64(1) << offsetIn(cell.second));
+            }
+        }
+        chunk.mines[row] = word;
+        chunk.numMines += qPopulationCount(word);
+    }
+}
+
+// Compute the number of surrounding mines for each cell of a chunk, a
+// row of 64 cells at a time as Board::calcMineCounts() does. Cells on
+// the chunk's edges need the mines of the neighboring chunks. Those not
+// in memory are generated just for this, so that counting doesn't create
+// (or restore) chunks in turn.
+void ChunkedBoard::calcMineCounts(Chunk &chunk, int chunkRow, int chunkCol) const
+{
+    // Mines of this chunk's column of chunks and the columns either side,
+    // from the last row of the chunk above to the first row of the one below
+    quint64 mines[3][ChunkSize + 2];
+    Chunk generated;
+    for (int dc = -1; dc <= 1; dc++) {
+        quint64 *column = mines[dc + 1];
+        for (int dr = -1; dr <= 1; dr++) {
+            int neighborRow = chunkRow + dr;
+            int neighborCol = chunkCol + dc;
+            bool onBoard = m_endless || (neighborRow >= 0 && neighborRow < m_chunkRows
+                                         && neighborCol >= 0 && neighborCol < m_chunkCols);
+            const quint64 *source = nullptr;
+            if (dr == 0 && dc == 0) {
+                source = chunk.mines;
+            } else if (onBoard) {
+                auto it = m_chunks.constFind(chunkKey(neighborRow, neighborCol));
+                if (it != m_chunks.constEnd()) {
+                    source = it.value().mines;
+                } else {
+                    generateMines(generated, neighborRow, neighborCol);
+                    source = generated.mines;
+                }
+            }
+            if (dr == -1) {
+                column[0] = source ? source[ChunkSize - 1] : 0;
+            } else if (dr == 1) {
+                column[ChunkSize + 1] = source ? source[0] : 0;
+            } else {
+                for (int row = 0; row < ChunkSize; row++) {
+                    column[row + 1] = source ? source[row] : 0;
+                }
+            }
+        }
+    }
+
+    auto westOf = [&](int row) {
+        return (mines[1][row] << 1) | (mines[0][row] >> 63);
+    };
+    auto eastOf = [&](int row) {
+        return (mines[1][row] >> 1) | (mines[2][row] << 63);
+    };
+    quint64 *counts = chunk.state.data() + FirstCountPlane * ChunkSize;
+    for (int row = 0; row < ChunkSize; row++) {
+        int above = row;
+        int current = row + 1;
+        int below = row + 2;
+
+        // Ones column: add the eight neighbor planes in groups of three
+        quint64 sumAbove, carryAbove;
+        fullAdd(westOf(above), mines[1][above], eastOf(above), sumAbove, carryAbove);
+        quint64 sumBelow, carryBelow;
+        fullAdd(westOf(below), mines[1][below], eastOf(below), sumBelow, carryBelow);
+        quint64 sumRows, carryRows;
+        fullAdd(sumAbove, sumBelow, westOf(current), sumRows, carryRows);
+        quint64 east = eastOf(current);
+        quint64 bit0 = sumRows ^ east;
+        quint64 carryEast = sumRows & east;
+
+        // Twos column: four carries from the ones column
+        quint64 sumTwos, carryTwos;
+        fullAdd(carryAbove, carryBelow, carryRows, sumTwos, carryTwos);
+        quint64 bit1 = sumTwos ^ carryEast;
+        quint64 carryFours = sumTwos & carryEast;
+
+        // Fours and eights columns
+        counts[0 * ChunkSize + row] = bit0;
+        counts[1 * ChunkSize + row] = bit1;
+        counts[2 * ChunkSize + row] = carryTwos ^ carryFours;
+        counts[3 * ChunkSize + row] = carryTwos & carryFours;
+    }
+}
+
+// Once more chunks than the limit are in memory, evict the least recently
+// used quarter of them, saving what the player changed in each
+void ChunkedBoard::evictChunks()
+{
+    if (m_chunkLimit <= 0 || m_chunks.size() < m_chunkLimit) {
+        return;
+    }
+
+    QVector<QPair<quint64, quint64>> byUse;
+    byUse.reserve(m_chunks.size());
+    for (auto it = m_chunks.constBegin(); it != m_chunks.constEnd(); ++it) {
+        byUse.append(qMakePair(it.value().lastUsed, it.key()));
+    }
+    int numEvicted = qMax(m_chunks.size() - m_chunkLimit * 3 / 4, 1);
+    std::nth_element(byUse.begin(), byUse.begin() + (numEvicted - 1), byUse.end());
+
+    for (int i = 0; i < numEvicted; i++) {
+        auto it = m_chunks.find(byUse[i].second);
+        saveChunk(it.value(), int(quint32(it.key() >> 32)), int(quint32(it.key())));
+        m_chunks.erase(it);
+    }
+    m_lastChunk = nullptr;
+}
+
+// Keep the flags and cleared cells of a chunk about to be evicted, if the
+// player has changed any
+void ChunkedBoard::saveChunk(const Chunk &chunk, int chunkRow, int chunkCol)
+{
+    if (chunk.state.isEmpty()) {
+        return;
+    }
+    const quint64 *flags = chunk.state.constData() + FlagsPlane * ChunkSize;
+    const quint64 *cleared = chunk.state.constData() + ClearedPlane * ChunkSize;
+    quint64 changed = 0;
+    for (int row = 0; row < ChunkSize; row++) {
+        changed |= flags[row] | (cleared[row] & ~offBoardBits(chunkRow, chunkCol, row));
+    }
+    if (!changed) {
+        return;
+    }
+
+    // Cleared cells, as run lengths of where they differ from the solved
+    // chunk (every cell but the mines cleared), starting with a run of
+    // cells that match it. Cells past the edge of the board always match,
+    // so a solved chunk is a single run and a partly solved one a few.
+    QVector<quint16> delta(1, 0);
+    bool inRun = false;
+    int runStart = 0;
+    for (int cell = 0; cell < CellsPerChunk; cell++) {
+        int row = cell / ChunkSize;
+        bool differs = ((cleared[row] ^ ~chunk.mines[row]) >> (cell % ChunkSize)) & 1;
+        if (differs != inRun) {
+            delta.append(quint16(cell - runStart));
+            runStart = cell;
+            inRun = differs;
+        }
+    }
+    delta.append(quint16(CellsPerChunk - runStart));
+    delta[0] = quint16(delta.size() - 1);
+
+    for (int row = 0; row < ChunkSize; row++) {
+        for (quint64 word = flags[row]; word; word &= word - 1) {
+            delta.append(quint16(row * ChunkSize + qCountTrailingZeroBits(word)));
+        }
+    }
+    m_savedChunks.insert(chunkKey(chunkRow, chunkCol), delta);
+}
+
+// Put back the flags and cleared cells saved when a chunk was evicted.
+// The chunk's mines must already be generated, since the cleared cells
+// were saved against them. The board's totals already include them.
+void ChunkedBoard::restoreChunk(Chunk &chunk, const QVector<quint16> &delta)
+{
+    quint64 *flags = chunk.state.data() + FlagsPlane * ChunkSize;
+    quint64 *cleared = chunk.state.data() + ClearedPlane * ChunkSize;
+    quint64 differs[ChunkSize] = {};
+    int numRuns = delta[0];
+    int cell = 0;
+    for (int run = 0; run < numRuns; run++) {
+        int end = cell + delta[1 + run];
+        if (run % 2 == 1) {
+            for (; cell < end; cell++) {
+                differs[cell / ChunkSize] |= quint64(1) << (cell % ChunkSize);
+            }
+        }
+        cell = end;
+    }
+    for (int row = 0; row < ChunkSize; row++) {
+        cleared[row] = ~chunk.mines[row] ^ differs[row];
+    }
+    for (int i = 1 + numRuns; i < delta.size(); i++) {
+        flags[delta[i] / ChunkSize] |= quint64(1) << (delta[i] % ChunkSize);
+    }
+}
@@ -0,0 +1,127 @@
+#ifndef CHUNKEDBOARD_H
+#define CHUNKEDBOARD_H
+
+#include "Random.h"
+#include <QHash>
+#include <QPair>
+#include <QVector>
+
+// A board stored in 64x64 chunks that are only created when play
+// reaches them
+//
+// Nothing is allocated up front, so a 100,000 x 100,000 board costs
+// only the chunks the player has touched. Each chunk's mines come from
+// the seed alone: the mine total is split between the two halves of
+// the board, then between the halves of those, down to single chunks,
+// with each split drawn from its own seeded stream. The chunk then
+// places its share with Floyd sampling. So any chunk can be generated
+// on its own, and the board holds exactly the requested number of mines.
+//
+// A chunk's mines are generated when it or one of its neighbors needs
+// them. Its flags, cleared cells and counts are allocated the first time
+// a reveal, flag or count touches it. Within a chunk, cells are stored
+// as bit-planes with one 64-bit word per row, as in Board, and cells
+// past the edge of the board are marked cleared.
+//
+// An endless board has no edges at all. There each cell is a mine when a
+// hash of the seed and its coordinates falls below the mine density, so
+// any chunk, anywhere, can be generated on its own.
+//
+// Only a window of recently used chunks is kept: once more than the
+// chunk limit exist, the least recently used are evicted. A chunk the
+// player has changed leaves behind a compact delta, and is rebuilt from
+// the seed and that delta when play comes back to it. The delta holds the
+// cells that differ from the solved chunk as run lengths, so a chunk the
+// player has cleared costs a few bytes, and the flags as a list. Deltas
+// are kept for as long as the game lasts, so while the chunks in memory
+// are bounded, the delta store grows with the area the player explores.
+
+class ChunkedBoard
+{
+public:
+    static const int ChunkSize = 64;
+    static const int DefaultChunkLimit = 4096;
+
+    ChunkedBoard();
+    void initialize(int rows, int cols, qint64 numMines, quint64 seed,
+                    int safeRow = -1, int safeCol = -1);
+    void initializeEndless(double mineDensity, quint64 seed, int safeRow, int safeCol);
+    bool isEndless() const;
+    int rows() const;
+    int cols() const;
+    qint64 numMines() const;
+    bool isValidCell(int row, int col) const;
+    bool hasMine(int row, int col);
+    int mineCount(int row, int col);
+    void toggleFlag(int row, int col);
+    void clearCell(int row, int col);
+    bool isFlagged(int row, int col);
+    bool isCleared(int row, int col);
+    bool mineTriggered() const;
+    bool allCellsCleared() const;
+    int numSurroundingFlags(int row, int col);
+    int numChunks() const;
+    QVector<QPair<int, int>> touchedChunks() const;
+    void setChunkLimit(int chunks);
+    int numSavedChunks() const;
+
+private:
+    struct Chunk
+    {
+        qint64 numMines;
+        // When the chunk was last looked up, for eviction
+        quint64 lastUsed;
+        quint64 mines[ChunkSize];
+        // Empty until the chunk is touched; then the flag plane, the
+        // cleared plane and the four count planes, one word per row
+        QVector<quint64> state;
+    };
+
+    int chunkHeight(int chunkRow) const;
+    int chunkWidth(int chunkCol) const;
+    qint64 cellsBefore(qint64 chunkIndex) const;
+    qint64 minesInChunk(qint64 chunkIndex) const;
+    Chunk *findChunk(int chunkRow, int chunkCol);
+    Chunk &chunk(int chunkRow, int chunkCol);
+    Chunk &touchedChunk(int chunkRow, int chunkCol);
+    Chunk *stateChunk(int chunkRow, int chunkCol);
+    void allocateState(Chunk &chunk, int chunkRow, int chunkCol);
+    quint64 offBoardBits(int chunkRow, int chunkCol, int row) const;
+    void generateMines(Chunk &chunk, int chunkRow, int chunkCol) const;
+    void generateEndlessMines(Chunk &chunk, int chunkRow, int chunkCol) const;
+    void calcMineCounts(Chunk &chunk, int chunkRow, int chunkCol) const;
+    void evictChunks();
+    void saveChunk(const Chunk &chunk, int chunkRow, int chunkCol);
+    void restoreChunk(Chunk &chunk, const QVector<quint16> &delta);
+
+private:
+    Q_DISABLE_COPY(ChunkedBoard)
+
+    QHash<quint64, Chunk> m_chunks;
+    // The last chunk looked up, since neighboring cells share chunks.
+    // Cleared when chunks are evicted.
+    quint64 m_lastKey;
+    Chunk *m_lastChunk;
+    quint64 m_useCount;
+    int m_chunkLimit;
+    // Player changes to evicted chunks: the number of cleared-cell runs,
+    // the run lengths (alternately matching and differing from the solved
+    // chunk, in row order), then the flagged cells, each as
+    // row * ChunkSize + column. Never pruned during a game.
+    QHash<quint64, QVector<quint16>> m_savedChunks;
+    bool m_endless;
+    // An endless board's cell is a mine when its hash is below this
+    quint64 m_mineThreshold;
+    int m_rows;
+    int m_cols;
+    int m_chunkRows;
+    int m_chunkCols;
+    qint64 m_numMines;
+    qint64 m_numLeftToClear;
+    quint64 m_seed;
+    bool m_mineTriggered;
+    // Cells kept clear of mines around the first click, as (row, column)
+    QVector<QPair<int, int>> m_safeCells;
+};
+
+#endif // CHUNKEDBOARD_H
@@ -0,0 +1,299 @@
+#include "ChunkedGameEngine.h"
+
+ChunkedGameEngine::ChunkedGameEngine()
+{
+    m_listener = &m_nullListener;
+    m_sliceSize = 0;
+    m_state = GameEngine::Playing;
+}
+
+// Set the listener told about game state changes
+void ChunkedGameEngine::setListener(GameListener *listener)
+{
+    m_listener = listener ? listener : &m_nullListener;
+}
+
+// Start a game. Nothing is generated until the player starts revealing.
+void ChunkedGameEngine::startGame(int rows, int cols, qint64 mines, quint64 seed, int safeRow, int safeCol)
+{
+    m_state = GameEngine::Playing;
+    m_pending.clear();
+    m_revealedCells.clear();
+    m_board.initialize(rows, cols, mines, seed, safeRow, safeCol);
+}
+
+// Start an endless game, where each cell is a mine with the given
+// probability. The cell given and its neighbors are always safe.
+void ChunkedGameEngine::startEndlessGame(double mineDensity, quint64 seed, int safeRow, int safeCol)
+{
+    m_state = GameEngine::Playing;
+    m_pending.clear();
+    m_revealedCells.clear();
+    m_board.initializeEndless(mineDensity, seed, safeRow, safeCol);
+}
+
+// Called when the player clicks a cell
+void ChunkedGameEngine::cellClicked(int row, int col)
+{
+    // Ignore clicks once the game is over, and clicks off the board
+    if (m_state != GameEngine::Playing || !m_board.isValidCell(row, col)) {
+        return;
+    }
+
+    // Don't let player accidentally click flagged cells
+    if (m_board.isFlagged(row, col)) {
+        return;
+    }
+
+    bool clearSurrounding = false;
+    if (!m_board.isCleared(row, col)) {
+        clearCell(row, col);
+        if (m_board.mineTriggered()) {
+            doGameLost();
+            return;
+        }
+        clearSurrounding = m_board.mineCount(row, col) == 0;
+    } else {
+        // Chord: clear around a count whose mines are all flagged
+        clearSurrounding = m_board.numSurroundingFlags(row, col) == m_board.mineCount(row, col);
+    }
+
+    if (clearSurrounding) {
+        clearNeighboringCells(row, col);
+    }
+    flushRevealedCells();
+}
+
+// Called when the player flags or unflags a cell
+void ChunkedGameEngine::cellFlagged(int row, int col)
+{
+    if (m_state != GameEngine::Playing || !m_board.isValidCell(row, col)) {
+        return;
+    }
+    if (!m_board.isCleared(row, col)) {
+        m_board.toggleFlag(row, col);
+        m_listener->setCellFlagged(row, col, m_board.isFlagged(row, col));
+    }
+}
+
+// Reveal openings at most this many cells at a time (no limit if not positive)
+void ChunkedGameEngine::setSliceSize(int cells)
+{
+    m_sliceSize = cells;
+}
+
+// Is an opening still being revealed?
+bool ChunkedGameEngine::hasPendingWork() const
+{
+    return m_state == GameEngine::Playing && !m_pending.isEmpty();
+}
+
+// Reveal the next slice of an opening
+void ChunkedGameEngine::continueWork()
+{
+    if (hasPendingWork()) {
+        runFill();
+        flushRevealedCells();
+    }
+}
+
+// Current state of the game
+GameEngine::State ChunkedGameEngine::state() const
+{
+    return m_state;
+}
+
+// Internal representation of the board
+ChunkedBoard &ChunkedGameEngine::board()
+{
+    return m_board;
+}
+
+// Clear a cell, revealing its contents
+void ChunkedGameEngine::clearCell(int row, int col)
+{
+    m_board.clearCell(row, col);
+    addRevealedCell(row, col);
+
+    // If this cell is a mine, game is over
+    if (m_board.hasMine(row, col)) {
+        flushRevealedCells();
+        m_listener->explode(row, col);
+    }
+
+    if (m_board.allCellsCleared()) {
+        doGameWon();
+    }
+}
+
+// Remember a cleared cell so the listener can be told about it
+void ChunkedGameEngine::addRevealedCell(int row, int col)
+{
+    RevealedCell cell;
+    cell.row = row;
+    cell.col = col;
+    cell.count = static_cast<quint8>(m_board.mineCount(row, col));
+    cell.hasMine = m_board.hasMine(row, col);
+    m_revealedCells.append(cell);
+}
+
+// Report the cells cleared so far, in slices if a slice size is set
+void ChunkedGameEngine::flushRevealedCells()
+{
+    if (m_revealedCells.isEmpty()) {
+        return;
+    }
+    if (m_sliceSize <= 0 || m_revealedCells.size() <= m_sliceSize) {
+        m_listener->cellsCleared(m_revealedCells);
+    } else {
+        for (int first = 0; first < m_revealedCells.size(); first += m_sliceSize) {
+            m_listener->cellsCleared(m_revealedCells.mid(first, m_sliceSize));
+        }
+    }
+    m_revealedCells.clear();
+}
+
+// Clear all the neighbors around a cell, and the openings they lead to
+void ChunkedGameEngine::clearNeighboringCells(int row, int col)
+{
+    m_pending.append(qMakePair(row, col));
+    runFill();
+}
+
+// Reveal queued openings, one slice of them if a slice size is set. Only
+// cells cleared by the fill are expanded, and flags stop it, as in
+// FloodFill.
+void ChunkedGameEngine::runFill()
+{
+    // Clearing the cell itself may already have won the game
+    if (m_state != GameEngine::Playing) {
+        return;
+    }
+
+    int firstCell = m_revealedCells.size();
+    int work = 0;
+    while (!m_pending.isEmpty() && (m_sliceSize <= 0 || work < m_sliceSize)) {
+        QPair<int, int> cell = m_pending.takeLast();
+        revealAround(cell.first, cell.second);
+        work += 9;
+    }
+
+    // Only the cells around a chorded cell can be mines; openings never are
+    if (m_board.mineTriggered()) {
+        RevealDelta mines;
+        for (int i = firstCell; i < m_revealedCells.size(); i++) {
+            if (m_revealedCells[i].hasMine) {
+                mines.append(m_revealedCells[i]);
+            }
+        }
+        flushRevealedCells();
+        for (const RevealedCell &mine : mines) {
+            m_listener->explode(mine.row, mine.col);
+        }
+        doGameLost();
+        return;
+    }
+
+    if (m_board.allCellsCleared()) {
+        doGameWon();
+    }
+}
+
+// Reveal the neighbors of a cell, queueing the empty ones to be expanded
+void ChunkedGameEngine::revealAround(int row, int col)
+{
+    for (int i = row - 1; i <= row + 1; i++) {
+        for (int j = col - 1; j <= col + 1; j++) {
+            if (!m_board.isValidCell(i, j) || m_board.isCleared(i, j) || m_board.isFlagged(i, j)) {
+                continue;
+            }
+            m_board.clearCell(i, j);
+            addRevealedCell(i, j);
+            if (m_board.mineCount(i, j) == 0 && !m_board.hasMine(i, j)) {
+                m_pending.append(qMakePair(i, j));
+            }
+        }
+    }
+}
+
+// Last row of the chunk starting at a row that is on the board
+int ChunkedGameEngine::lastRowOfChunk(int firstRow) const
+{
+    int lastRow = firstRow + ChunkedBoard::ChunkSize - 1;
+    return m_board.isEndless() ? lastRow : qMin(lastRow, m_board.rows() - 1);
+}
+
+// Last column of the chunk starting at a column that is on the board
+int ChunkedGameEngine::lastColOfChunk(int firstCol) const
+{
+    int lastCol = firstCol + ChunkedBoard::ChunkSize - 1;
+    return m_board.isEndless() ? lastCol : qMin(lastCol, m_board.cols() - 1);
+}
+
+// Clear the touched part of the board after the game has been lost
+void ChunkedGameEngine::clearAllCells()
+{
+    for (const QPair<int, int> &chunk : m_board.touchedChunks()) {
+        int firstRow = chunk.first * ChunkedBoard::ChunkSize;
+        int firstCol = chunk.second * ChunkedBoard::ChunkSize;
+        int lastRow = lastRowOfChunk(firstRow);
+        int lastCol = lastColOfChunk(firstCol);
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int col = firstCol; col <= lastCol; col++) {
+                if (m_board.isCleared(row, col)) {
+                    continue;
+                }
+                // Clear non-flagged cells, and mark incorrectly flagged ones
+                if (!m_board.isFlagged(row, col)) {
+                    m_board.clearCell(row, col);
+                    addRevealedCell(row, col);
+                } else if (!m_board.hasMine(row, col)) {
+                    m_listener->markIncorrectlyFlaggedCell(row, col);
+                }
+            }
+        }
+    }
+    flushRevealedCells();
+}
+
+// Called after winning the game to flag mines that were not flagged by the
+// player. Only a bounded board can be won, and every cell of it has been
+// cleared by then, so this walks the whole board a chunk at a time. Chunks
+// that were evicted, or that hold nothing but mines and so were never
+// touched, are generated again as they're reached.
+void ChunkedGameEngine::flagAllBombs()
+{
+    for (int firstRow = 0; firstRow < m_board.rows(); firstRow += ChunkedBoard::ChunkSize) {
+        for (int firstCol = 0; firstCol < m_board.cols(); firstCol += ChunkedBoard::ChunkSize) {
+            int lastRow = lastRowOfChunk(firstRow);
+            int lastCol = lastColOfChunk(firstCol);
+            for (int row = firstRow; row <= lastRow; row++) {
+                for (int col = firstCol; col <= lastCol; col++) {
+                    if (!m_board.isFlagged(row, col) && m_board.hasMine(row, col)) {
+                        m_listener->setCellFlagged(row, col, true);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Player loses
+void ChunkedGameEngine::doGameLost()
+{
+    m_state = GameEngine::Lost;
+    m_pending.clear();
+    flushRevealedCells();
+    m_listener->gameLost();
+    clearAllCells();
+}
+
+// Player wins
+void ChunkedGameEngine::doGameWon()
+{
+    m_state = GameEngine::Won;
+    m_pending.clear();
+    flushRevealedCells();
+    m_listener->gameWon();
+    flagAllBombs();
+}
@@ -0,0 +1,60 @@
+#ifndef CHUNKEDGAMEENGINE_H
+#define CHUNKEDGAMEENGINE_H
+
+#include "ChunkedBoard.h"
+#include "GameEngine.h"
+
+// Game logic for boards too large to hold in memory, on a ChunkedBoard
+//
+// Plays by the same rules as GameEngine and reports the same changes to
+// its GameListener. Reveals touch only the chunks they reach, and can be
+// run a slice at a time like GameEngine's. Losing reveals the chunks the
+// player has touched, including evicted ones, rather than all of them,
+// since the rest have never been generated.
+//
+// An endless game can't be won; it goes on until the player hits a mine.
+
+class ChunkedGameEngine
+{
+public:
+    ChunkedGameEngine();
+    void setListener(GameListener *listener);
+    void startGame(int rows, int cols, qint64 mines, quint64 seed,
+                   int safeRow = -1, int safeCol = -1);
+    void startEndlessGame(double mineDensity, quint64 seed, int safeRow, int safeCol);
+    void cellClicked(int row, int col);
+    void cellFlagged(int row, int col);
+    void setSliceSize(int cells);
+    bool hasPendingWork() const;
+    void continueWork();
+    GameEngine::State state() const;
+    ChunkedBoard &board();
+
+private:
+    void clearCell(int row, int col);
+    void addRevealedCell(int row, int col);
+    void flushRevealedCells();
+    void clearNeighboringCells(int row, int col);
+    void runFill();
+    void revealAround(int row, int col);
+    int lastRowOfChunk(int firstRow) const;
+    int lastColOfChunk(int firstCol) const;
+    void clearAllCells();
+    void flagAllBombs();
+    void doGameLost();
+    void doGameWon();
+
+private:
+    ChunkedBoard m_board;
+    int m_sliceSize;
+    GameListener *m_listener;
+    GameListener m_nullListener;
+    GameEngine::State m_state;
+    // Cells whose neighbors are still to be revealed: cells the player
+    // asked to clear around, and empty cells revealed by the fill
+    QVector<QPair<int, int>> m_pending;
+    // Cells cleared by the current player action, not yet reported
+    RevealDelta m_revealedCells;
+};
+
+#endif // CHUNKEDGAMEENGINE_H
@@ -0,0 +1,388 @@
+#include "EngineThread.h"
+
+namespace {
+
+// Queue sizes. Commands come from the player, so are few; a single
+// command can produce several events.
+const int CommandCapacity = 256;
+const int EventCapacity = 1024;
+
+// Cells visited per slice of a large opening, about a millisecond of work
+const int SliceSize = 8192;
+
+// Would clicking this cell first open the same area as clicking the
+// centre of the board? If so, a no-guess board generated for the centre
+// can be solved from it too.
+bool opensLikeCentre(const Board &board, int row, int col)
+{
+    GameEngine engine;
+    engine.startGame(board);
+    engine.cellClicked(board.rows() / 2, board.cols() / 2);
+    Board &opened = engine.board();
+    return opened.isCleared(row, col) && opened.mineCount(row, col) == 0;
+}
+
+}
+
+EngineThread::EngineThread(QObject *parent)
+    : QThread(parent), m_commands(CommandCapacity), m_events(EventCapacity)
+{
+    m_waitingForFirstClick = false;
+    m_game = 0;
+    m_quitting.storeRelease(0);
+    m_engine.setListener(this);
+    m_engine.setSliceSize(SliceSize);
+}
+
+EngineThread::~EngineThread()
+{
+    m_quitting.storeRelease(1);
+    GameCommand command = {};
+    command.type = GameCommand::Quit;
+    // Discard events while waiting, in case the engine is blocked posting one
+    GameEvent event;
+    while (isRunning() && !sendCommand(command)) {
+        while (nextEvent(event)) {
+        }
+        yieldCurrentThread();
+    }
+    while (!wait(10)) {
+        while (nextEvent(event)) {
+        }
+    }
+}
+
+// Queue a command for the engine (UI thread only). Returns false if the
+// queue is full; the UI never blocks on the engine.
+bool EngineThread::sendCommand(const GameCommand &command)
+{
+    if (!m_commands.push(command)) {
+        return false;
+    }
+    m_commandsReady.release();
+    return true;
+}
+
+// Take the next event from the engine (UI thread only)
+bool EngineThread::nextEvent(GameEvent &event)
+{
+    return m_events.pop(event);
+}
+
+// Called by the UI before draining events, so that events posted from
+// now on send eventsReady() again
+void EngineThread::eventsDrained()
+{
+    m_notifyPending.storeRelease(0);
+}
+
+// Engine thread: wait for commands and apply them one at a time. While an
+// opening is being revealed, new commands are let in between slices.
+void EngineThread::run()
+{
+    while (true) {
+        if (m_engine.hasPendingWork()) {
+            if (!m_commandsReady.tryAcquire()) {
+                m_engine.continueWork();
+                continue;
+            }
+        } else {
+            m_commandsReady.acquire();
+        }
+        GameCommand command;
+        if (!m_commands.pop(command)) {
+            continue;
+        }
+        if (command.type == GameCommand::Quit) {
+            return;
+        }
+        handleCommand(command);
+    }
+}
+
+void EngineThread::handleCommand(const GameCommand &command)
+{
+    switch (command.type) {
+    case GameCommand::StartGame:
+        m_game = command.game;
+        m_waitingForFirstClick = false;
+        if (command.hasBoard) {
+            startEngine(command.board, command.seed);
+        } else {
+            // Placing mines and counting them takes a while on large boards,
+            // so it's done here rather than on the UI thread
+            Board board;
+            board.initialize(command.rows, command.cols, command.mines, command.seed);
+            startEngine(board, command.seed);
+        }
+        break;
+    case GameCommand::StartNoGuessGame:
+        // The board depends on where the first click is
+        m_game = command.game;
+        m_waitingForFirstClick = true;
+        m_noGuessGame = command;
+        break;
+    case GameCommand::Click:
+        if (m_waitingForFirstClick) {
+            firstClick(command.row, command.col);
+        } else {
+            recordAction(command);
+            m_engine.cellClicked(command.row, command.col);
+        }
+        break;
+    case GameCommand::Flag:
+        // There is no board to flag until the first click has been made
+        if (!m_waitingForFirstClick) {
+            recordAction(command);
+            m_engine.cellFlagged(command.row, command.col);
+        }
+        break;
+    case GameCommand::SaveRecord:
+        m_record.saveToFile(command.path);
+        break;
+    case GameCommand::SaveSnapshot:
+        // An opening still being revealed is finished first, or the saved
+        // board would have it half open. Only a game in progress can be
+        // resumed.
+        while (m_engine.hasPendingWork()) {
+            m_engine.continueWork();
+        }
+        if (!m_waitingForFirstClick && m_engine.state() == GameEngine::Playing) {
+            m_engine.board().saveSnapshot(command.path);
+        }
+        break;
+    case GameCommand::ResumeGame:
+        m_game = command.game;
+        m_waitingForFirstClick = false;
+        startEngine(command.board, command.seed);
+        recordRestoredCells();
+        restoreCells();
+        break;
+    case GameCommand::Quit:
+        break;
+    }
+}
+
+// Start a no-guess game from its first click, on the offered board if it
+// fits the click and on a newly generated one if not. If no board can be
+// generated, the UI is told and the game is left waiting for a first click.
+void EngineThread::firstClick(int row, int col)
+{
+    const GameCommand &game = m_noGuessGame;
+    quint64 seed = game.seed;
+    Board board;
+    if (game.hasBoard && opensLikeCentre(game.board, row, col)) {
+        board = game.board;
+    } else if (!m_generator.generate(game.rows, game.cols, game.mines, row, col, game.seed, board,
+                                     &m_quitting)) {
+        if (!m_quitting.loadAcquire()) {
+            GameEvent event = {};
+            event.type = GameEvent::NoGuessFailed;
+            postEvent(event);
+        }
+        return;
+    }
+    m_waitingForFirstClick = false;
+    m_noGuessGame = GameCommand();
+    startEngine(board, seed, row, col);
+
+    GameCommand click = {};
+    click.type = GameCommand::Click;
+    click.row = row;
+    click.col = col;
+    recordAction(click);
+    m_engine.cellClicked(row, col);
+}
+
+// Start a game and tell the UI where the mines are (for debug/cheat hints),
+// in slices so that the UI can keep to its frame budget. The record keeps
+// the seed, and the safe first click if there was one.
+void EngineThread::startEngine(const Board &board, quint64 seed, int safeRow, int safeCol)
+{
+    m_engine.startGame(board);
+    m_record.start(board, seed, safeRow, safeCol);
+    m_recordClock.start();
+
+    GameEvent event = {};
+    event.type = GameEvent::MinesPlaced;
+    Board &engineBoard = m_engine.board();
+    for (int row = 0; row < engineBoard.rows(); row++) {
+        for (int col = 0; col < engineBoard.cols(); col++) {
+            if (engineBoard.hasMine(row, col)) {
+                RevealedCell cell = { row, col, 0, true };
+                event.cells.append(cell);
+                if (event.cells.size() >= SliceSize) {
+                    postEvent(event);
+                    event.cells.clear();
+                }
+            }
+        }
+    }
+    if (!event.cells.isEmpty()) {
+        postEvent(event);
+    }
+}
+
+// Add a player action to the game's record. A click on a cleared cell
+// is a chord. Actions that can't change the game are left out.
+void EngineThread::recordAction(const GameCommand &command)
+{
+    Board &board = m_engine.board();
+    if (m_engine.state() != GameEngine::Playing || command.row < 0 || command.row >= board.rows()
+            || command.col < 0 || command.col >= board.cols()) {
+        return;
+    }
+    GameRecord::ActionType type = GameRecord::Flag;
+    if (command.type == GameCommand::Click) {
+        type = board.isCleared(command.row, command.col) ? GameRecord::Chord : GameRecord::Click;
+    }
+    m_record.addAction(type, command.row, command.col, m_recordClock.elapsed());
+}
+
+// Add actions at the start of a resumed game's record that clear and flag
+// the cells the snapshot had cleared and flagged. They are played on a
+// fresh board first: a click is only recorded for a cell no earlier click
+// has cleared, and cells next to a cleared opening that were left covered
+// are flagged while clicking, so that openings stop where they did.
+void EngineThread::recordRestoredCells()
+{
+    Board &board = m_engine.board();
+    GameEngine replay;
+    replay.startGame(m_record.board());
+    QVector<int> heldBack;
+    for (int row = 0; row < board.rows(); row++) {
+        for (int col = 0; col < board.cols(); col++) {
+            if (board.isCleared(row, col)) {
+                continue;
+            }
+            bool flag = board.isFlagged(row, col);
+            if (!flag) {
+                for (int r = qMax(row - 1, 0); r <= qMin(row + 1, board.rows() - 1) && !flag; r++) {
+                    for (int c = qMax(col - 1, 0); c <= qMin(col + 1, board.cols() - 1); c++) {
+                        if (board.isCleared(r, c) && board.mineCount(r, c) == 0) {
+                            flag = true;
+                            heldBack.append(row * board.cols() + col);
+                            break;
+                        }
+                    }
+                }
+            }
+            if (flag) {
+                replay.cellFlagged(row, col);
+                m_record.addAction(GameRecord::Flag, row, col, 0);
+            }
+        }
+    }
+    for (int row = 0; row < board.rows(); row++) {
+        for (int col = 0; col < board.cols(); col++) {
+            if (board.isCleared(row, col) && !replay.board().isCleared(row, col)) {
+                replay.cellClicked(row, col);
+                m_record.addAction(GameRecord::Click, row, col, 0);
+            }
+        }
+    }
+    for (int cell : heldBack) {
+        m_record.addAction(GameRecord::Flag, cell / board.cols(), cell % board.cols(), 0);
+    }
+}
+
+// Tell the UI about the cells already cleared and flagged on a resumed
+// board, in slices like a large opening
+void EngineThread::restoreCells()
+{
+    Board &board = m_engine.board();
+    GameEvent event = {};
+    event.type = GameEvent::CellsCleared;
+    for (int row = 0; row < board.rows(); row++) {
+        for (int col = 0; col < board.cols(); col++) {
+            if (board.isFlagged(row, col)) {
+                setCellFlagged(row, col, true);
+            }
+            if (board.isCleared(row, col)) {
+                RevealedCell cell = { row, col, static_cast<quint8>(board.mineCount(row, col)),
+                                      board.hasMine(row, col) };
+                event.cells.append(cell);
+                if (event.cells.size() >= SliceSize) {
+                    postEvent(event);
+                    event.cells.clear();
+                }
+            }
+        }
+    }
+    if (!event.cells.isEmpty()) {
+        postEvent(event);
+    }
+}
+
+// Queue an event for the UI. If the UI has fallen behind and the queue is
+// full, wait for it to catch up rather than drop the event.
+void EngineThread::postEvent(GameEvent &event)
+{
+    event.game = m_game;
+    while (!m_events.push(event)) {
+        notify();
+        yieldCurrentThread();
+    }
+    notify();
+}
+
+// Tell the UI there are events, unless it has already been told
+void EngineThread::notify()
+{
+    if (m_notifyPending.testAndSetOrdered(0, 1)) {
+        emit eventsReady();
+    }
+}
+
+//
+// Forward game state changes from the engine to the UI
+//
+void EngineThread::cellsCleared(const RevealDelta &cells)
+{
+    GameEvent event = {};
+    event.type = GameEvent::CellsCleared;
+    event.cells = cells;
+    postEvent(event);
+}
+
+void EngineThread::setCellFlagged(int row, int col, bool flagged)
+{
+    GameEvent event = {};
+    event.type = GameEvent::CellFlagged;
+    event.row = row;
+    event.col = col;
+    event.flagged = flagged;
+    postEvent(event);
+}
+
+void EngineThread::explode(int row, int col)
+{
+    GameEvent event = {};
+    event.type = GameEvent::Explode;
+    event.row = row;
+    event.col = col;
+    postEvent(event);
+}
+
+void EngineThread::markIncorrectlyFlaggedCell(int row, int col)
+{
+    GameEvent event = {};
+    event.type = GameEvent::MarkIncorrectlyFlagged;
+    event.row = row;
+    event.col = col;
+    postEvent(event);
+}
+
+void EngineThread::gameWon()
+{
+    GameEvent event = {};
+    event.type = GameEvent::GameWon;
+    postEvent(event);
+}
+
+void EngineThread::gameLost()
+{
+    GameEvent event = {};
+    event.type = GameEvent::GameLost;
+    postEvent(event);
+}
@@ -0,0 +1,143 @@
+#ifndef ENGINETHREAD_H
+#define ENGINETHREAD_H
+
+#include "GameEngine.h"
+#include "GameRecord.h"
+#include "NoGuessGenerator.h"
+#include "SpscQueue.h"
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QSemaphore>
+#include <QThread>
+
+// A request from the UI to the game engine
+struct GameCommand
+{
+    enum Type {
+        StartGame,
+        StartNoGuessGame,
+        Click,
+        Flag,
+        SaveRecord,
+        SaveSnapshot,
+        ResumeGame,
+        Quit
+    };
+
+    Type type;
+    // Number of the game the command belongs to, set by the UI
+    int game;
+    int row;
+    int col;
+    // StartGame plays board if hasBoard is set, and otherwise generates
+    // one from the seed; StartNoGuessGame may offer a board made for a
+    // first click in the centre, and otherwise generates one from the seed
+    int rows;
+    int cols;
+    int mines;
+    quint64 seed;
+    bool hasBoard;
+    Board board;
+    // File SaveRecord and SaveSnapshot write the current game to
+    QString path;
+};
+
+// A game state change from the engine to the UI
+struct GameEvent
+{
+    enum Type {
+        MinesPlaced,
+        CellsCleared,
+        CellFlagged,
+        Explode,
+        MarkIncorrectlyFlagged,
+        GameWon,
+        GameLost,
+        NoGuessFailed
+    };
+
+    Type type;
+    // Number of the game the event came from, so that the UI can drop
+    // events from a game it has already replaced
+    int game;
+    int row;
+    int col;
+    bool flagged;
+    // Cells revealed, or mines for MinesPlaced (in slices, like reveals)
+    RevealDelta cells;
+};
+
+// Runs a GameEngine on its own thread
+//
+// Commands go in through one single-producer, single-consumer queue and
+// events come back through another, so neither side ever waits on a
+// lock. A semaphore wakes the engine thread when commands arrive. The
+// eventsReady() signal is sent once until the events are drained, so a
+// burst of work costs the UI one queued call, made on its next turn of
+// the event loop. Large openings are revealed in slices, each published
+// as it is done.
+//
+// Every game is recorded as it is played, and SaveRecord writes the
+// record of the current game to a file. SaveSnapshot saves the board as
+// it stands, and ResumeGame carries on from a board loaded from one. The
+// record of a resumed game starts with the flags and clicks that bring a
+// fresh board to where the snapshot left off.
+//
+// If a no-guess board can't be generated for the first click, the UI is
+// sent NoGuessFailed and the game waits for another first click, rather
+// than being started on a board that may need guessing.
+
+class EngineThread : public QThread, private GameListener
+{
+    Q_OBJECT
+public:
+    explicit EngineThread(QObject *parent = nullptr);
+    ~EngineThread() override;
+    bool sendCommand(const GameCommand &command);
+    bool nextEvent(GameEvent &event);
+    void eventsDrained();
+
+signals:
+    void eventsReady();
+
+protected:
+    void run() override;
+
+private:
+    void handleCommand(const GameCommand &command);
+    void firstClick(int row, int col);
+    void startEngine(const Board &board, quint64 seed, int safeRow = -1, int safeCol = -1);
+    void recordAction(const GameCommand &command);
+    void recordRestoredCells();
+    void restoreCells();
+    void postEvent(GameEvent &event);
+    void notify();
+
+    // GameListener interface
+    void cellsCleared(const RevealDelta &cells) override;
+    void setCellFlagged(int row, int col, bool flagged) override;
+    void explode(int row, int col) override;
+    void markIncorrectlyFlaggedCell(int row, int col) override;
+    void gameWon() override;
+    void gameLost() override;
+
+private:
+    // Shared with the UI thread
+    SpscQueue<GameCommand> m_commands;
+    SpscQueue<GameEvent> m_events;
+    QSemaphore m_commandsReady;
+    QAtomicInt m_notifyPending;
+    // Set when the thread is being destroyed, to cut short generation
+    QAtomicInt m_quitting;
+
+    // Only used on the engine thread
+    GameEngine m_engine;
+    NoGuessGenerator m_generator;
+    GameCommand m_noGuessGame;
+    GameRecord m_record;
+    QElapsedTimer m_recordClock;
+    bool m_waitingForFirstClick;
+    int m_game;
+};
+
+#endif // ENGINETHREAD_H
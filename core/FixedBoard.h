@@ -0,0 +1,140 @@
+#ifndef FIXEDBOARD_H
+#define FIXEDBOARD_H
+
+#include "Random.h"
+
+// A board whose size is fixed at compile time, for the standard
+// difficulties
+//
+// Each cell is one byte (its count in the low four bits, then mine, flag
+// and cleared bits) in a plain array with a one-cell sentinel border, so
+// a Hard board fits in a few cache lines. The row stride is a constant,
+// neighbor loops are unrolled, and the sentinels are marked cleared so
+// that reveals stop at the edge without bounds checks.
+//
+// Mines are placed exactly as Board::initialize() places them, so a seed
+// gives the same board at either size.
+
+template <int Rows, int Cols>
+class FixedBoard
+{
+public:
+    static const int Stride = Cols + 2;
+    static const int NumCells = Rows * Cols;
+    static const int NumIndexes = (Rows + 2) * Stride;
+
+    FixedBoard()
+    {
+        initialize(0, 0);
+    }
+
+    // Place numMines mines from seed. Uses the same Floyd sampling over the
+    // same random stream as Board::setMines(), so the mines land on the
+    // same cells as on a Board of this size.
+    void initialize(int numMines, quint64 seed)
+    {
+        // Sentinels are cleared; board cells start out empty
+        for (int index = 0; index < NumIndexes; index++) {
+            m_cells[index] = Cleared;
+        }
+        for (int row = 0; row < Rows; row++) {
+            for (int col = 0; col < Cols; col++) {
+                m_cells[cellIndex(row, col)] = 0;
+            }
+        }
+
+        numMines = qBound(0, numMines, NumCells);
+        Random random(seed);
+        for (int last = NumCells - numMines; last < NumCells; last++) {
+            int cell = static_cast<int>(random.bounded(static_cast<quint64>(last) + 1));
+            // If that cell is taken, the newly available cell can't be
+            if (hasMine(cellIndex(cell / Cols, cell % Cols))) {
+                cell = last;
+            }
+            int index = cellIndex(cell / Cols, cell % Cols);
+            m_cells[index] |= Mine;
+            // Counts are at most 8, so never carry into the mine bit.
+            // Sentinel counts are never read.
+            forEachNeighbor(index, [this](int neighbor) {
+                m_cells[neighbor]++;
+            });
+        }
+
+        m_numMines = numMines;
+        m_numLeftToClear = NumCells - numMines;
+        m_mineTriggered = false;
+    }
+
+    int numMines() const { return m_numMines; }
+    bool mineTriggered() const { return m_mineTriggered; }
+    bool allCellsCleared() const { return m_numLeftToClear <= 0; }
+
+    static bool isValidCell(int row, int col)
+    {
+        return row >= 0 && row < Rows && col >= 0 && col < Cols;
+    }
+
+    static int cellIndex(int row, int col) { return (row + 1) * Stride + col + 1; }
+    static int rowOf(int index) { return index / Stride - 1; }
+    static int colOf(int index) { return index % Stride - 1; }
+
+    // Call function with the index of each of a cell's eight neighbors
+    template <typename Function>
+    static void forEachNeighbor(int index, Function function)
+    {
+        function(index - Stride - 1);
+        function(index - Stride);
+        function(index - Stride + 1);
+        function(index - 1);
+        function(index + 1);
+        function(index + Stride - 1);
+        function(index + Stride);
+        function(index + Stride + 1);
+    }
+
+    // By cell index, which must be of a board cell
+    bool hasMine(int index) const { return m_cells[index] & Mine; }
+    int mineCount(int index) const { return m_cells[index] & CountMask; }
+    bool isFlagged(int index) const { return m_cells[index] & Flagged; }
+    bool isCleared(int index) const { return m_cells[index] & Cleared; }
+    void toggleFlag(int index) { m_cells[index] ^= Flagged; }
+
+    // Clear a cell, revealing a mine or count
+    void clearCell(int index)
+    {
+        if (isCleared(index)) {
+            return;
+        }
+        m_cells[index] |= Cleared;
+        if (hasMine(index)) {
+            m_mineTriggered = true;
+        } else {
+            m_numLeftToClear--;
+        }
+    }
+
+    // Return the number of surrounding cells that have been flagged
+    int numSurroundingFlags(int index) const
+    {
+        int numFlags = 0;
+        forEachNeighbor(index, [this, &numFlags](int neighbor) {
+            numFlags += isFlagged(neighbor);
+        });
+        return numFlags;
+    }
+
+private:
+    enum {
+        CountMask = 0x0f,
+        Mine = 0x10,
+        Flagged = 0x20,
+        Cleared = 0x40
+    };
+
+    quint8 m_cells[NumIndexes];
+    int m_numMines;
+    int m_numLeftToClear;
+    bool m_mineTriggered;
+};
+
+#endif // FIXEDBOARD_H
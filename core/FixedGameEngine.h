@@ -0,0 +1,238 @@
+#ifndef FIXEDGAMEENGINE_H
+#define FIXEDGAMEENGINE_H
+
+#include "FixedBoard.h"
+#include "GameEngine.h"
+
+// Game logic for a board whose size is fixed at compile time
+//
+// Plays by the same rules as GameEngine and reports the same changes to
+// its GameListener, so code written against GameEngine's playing
+// interface can take either. Openings are revealed with a flood fill over
+// a fixed-size stack, always to completion; there is no slicing, since
+// the standard boards are small.
+
+template <int Rows, int Cols>
+class FixedGameEngine
+{
+public:
+    typedef FixedBoard<Rows, Cols> BoardType;
+
+    FixedGameEngine()
+    {
+        m_listener = &m_nullListener;
+        m_state = GameEngine::Playing;
+    }
+
+    // Set the listener told about game state changes
+    void setListener(GameListener *listener)
+    {
+        m_listener = listener ? listener : &m_nullListener;
+    }
+
+    // Start a game. rows and cols must be the board's own.
+    void startGame(int rows, int cols, int mines, quint64 seed)
+    {
+        Q_ASSERT(rows == Rows && cols == Cols);
+        Q_UNUSED(rows)
+        Q_UNUSED(cols)
+        m_state = GameEngine::Playing;
+        m_revealedCells.clear();
+        m_board.initialize(mines, seed);
+    }
+
+    // Called when the player clicks a cell
+    void cellClicked(int row, int col)
+    {
+        // Ignore clicks once the game is over, and clicks off the board
+        if (m_state != GameEngine::Playing || !BoardType::isValidCell(row, col)) {
+            return;
+        }
+        int index = BoardType::cellIndex(row, col);
+
+        // Don't let player accidentally click flagged cells
+        if (m_board.isFlagged(index)) {
+            return;
+        }
+
+        bool clearSurrounding = false;
+        if (!m_board.isCleared(index)) {
+            clearCell(index);
+            if (m_board.mineTriggered()) {
+                doGameLost();
+                return;
+            }
+            clearSurrounding = m_board.mineCount(index) == 0;
+        } else {
+            // Chord: clear around a count whose mines are all flagged
+            clearSurrounding = m_board.numSurroundingFlags(index) == m_board.mineCount(index);
+        }
+
+        if (clearSurrounding) {
+            clearNeighboringCells(index);
+        }
+        flushRevealedCells();
+    }
+
+    // Called when the player flags or unflags a cell
+    void cellFlagged(int row, int col)
+    {
+        if (m_state != GameEngine::Playing || !BoardType::isValidCell(row, col)) {
+            return;
+        }
+        int index = BoardType::cellIndex(row, col);
+        if (!m_board.isCleared(index)) {
+            m_board.toggleFlag(index);
+            m_listener->setCellFlagged(row, col, m_board.isFlagged(index));
+        }
+    }
+
+    // Current state of the game
+    GameEngine::State state() const
+    {
+        return m_state;
+    }
+
+    // Internal representation of the board
+    BoardType &board()
+    {
+        return m_board;
+    }
+
+private:
+    // Clear a cell, revealing its contents
+    void clearCell(int index)
+    {
+        m_board.clearCell(index);
+        addRevealedCell(index);
+
+        // If this cell is a mine, game is over
+        if (m_board.hasMine(index)) {
+            flushRevealedCells();
+            m_listener->explode(BoardType::rowOf(index), BoardType::colOf(index));
+        }
+
+        if (m_board.allCellsCleared()) {
+            doGameWon();
+        }
+    }
+
+    // Remember a cleared cell so the listener can be told about it
+    void addRevealedCell(int index)
+    {
+        RevealedCell cell;
+        cell.row = BoardType::rowOf(index);
+        cell.col = BoardType::colOf(index);
+        cell.count = static_cast<quint8>(m_board.mineCount(index));
+        cell.hasMine = m_board.hasMine(index);
+        m_revealedCells.append(cell);
+    }
+
+    // Report the cells cleared so far as a single update
+    void flushRevealedCells()
+    {
+        if (!m_revealedCells.isEmpty()) {
+            m_listener->cellsCleared(m_revealedCells);
+            m_revealedCells.clear();
+        }
+    }
+
+    // Clear the neighbors of a cell, and the openings they lead to. Only
+    // cells cleared by this fill are expanded; flags and the sentinel
+    // border (which is cleared) stop it.
+    void clearNeighboringCells(int index)
+    {
+        // Clearing the cell itself may already have won the game
+        if (m_state != GameEngine::Playing) {
+            return;
+        }
+
+        int firstCell = m_revealedCells.size();
+        int numPending = 0;
+        auto reveal = [this, &numPending](int neighbor) {
+            if (m_board.isCleared(neighbor) || m_board.isFlagged(neighbor)) {
+                return;
+            }
+            m_board.clearCell(neighbor);
+            addRevealedCell(neighbor);
+            if (m_board.mineCount(neighbor) == 0 && !m_board.hasMine(neighbor)) {
+                m_pending[numPending++] = neighbor;
+            }
+        };
+        BoardType::forEachNeighbor(index, reveal);
+        while (numPending > 0) {
+            BoardType::forEachNeighbor(m_pending[--numPending], reveal);
+        }
+
+        // Only the cells around a chorded cell can be mines; openings never are
+        if (m_board.mineTriggered()) {
+            RevealDelta mines;
+            for (int i = firstCell; i < m_revealedCells.size(); i++) {
+                if (m_revealedCells[i].hasMine) {
+                    mines.append(m_revealedCells[i]);
+                }
+            }
+            flushRevealedCells();
+            for (const RevealedCell &mine : mines) {
+                m_listener->explode(mine.row, mine.col);
+            }
+            doGameLost();
+            return;
+        }
+
+        if (m_board.allCellsCleared()) {
+            doGameWon();
+        }
+    }
+
+    // Player loses: clear all cells, marking incorrect flags
+    void doGameLost()
+    {
+        m_state = GameEngine::Lost;
+        flushRevealedCells();
+        m_listener->gameLost();
+        for (int row = 0; row < Rows; row++) {
+            for (int col = 0; col < Cols; col++) {
+                int index = BoardType::cellIndex(row, col);
+                if (m_board.isCleared(index)) {
+                    continue;
+                }
+                if (!m_board.isFlagged(index)) {
+                    m_board.clearCell(index);
+                    addRevealedCell(index);
+                } else if (!m_board.hasMine(index)) {
+                    m_listener->markIncorrectlyFlaggedCell(row, col);
+                }
+            }
+        }
+        flushRevealedCells();
+    }
+
+    // Player wins: flag the mines the player didn't
+    void doGameWon()
+    {
+        m_state = GameEngine::Won;
+        flushRevealedCells();
+        m_listener->gameWon();
+        for (int row = 0; row < Rows; row++) {
+            for (int col = 0; col < Cols; col++) {
+                int index = BoardType::cellIndex(row, col);
+                if (!m_board.isFlagged(index) && m_board.hasMine(index)) {
+                    m_listener->setCellFlagged(row, col, true);
+                }
+            }
+        }
+    }
+
+private:
+    BoardType m_board;
+    GameListener *m_listener;
+    GameListener m_nullListener;
+    GameEngine::State m_state;
+    // Cells cleared by the current player action, not yet reported
+    RevealDelta m_revealedCells;
+    // Empty cells cleared by the fill whose neighbors are still to be cleared
+    int m_pending[BoardType::NumCells];
+};
+
+#endif // FIXEDGAMEENGINE_H
@@ -0,0 +1,144 @@
+#include "FloodFill.h"
+
+// Forget any fill in progress and size the bitmaps for a new board
+void FloodFill::reset(const Board &board)
+{
+    m_around.clear();
+    m_seeds.clear();
+    m_openingsRevealed.clear();
+    int numWords = (board.numCellIndexes() + 63) / 64;
+    m_revealed.fill(0, numWords);
+    m_expanded.fill(0, numWords);
+}
+
+// Queue the neighbors of a cell (by board cell index) to be revealed,
+// along with the openings they lead to
+void FloodFill::revealAround(int cell)
+{
+    m_around.append(cell);
+}
+
+// Has everything queued been revealed?
+bool FloodFill::isFinished() const
+{
+    return m_around.isEmpty() && m_seeds.isEmpty();
+}
+
+// Reveal queued cells, appending them to revealed, until the fill is
+// finished or about maxWork cells have been visited (no limit if maxWork
+// is not positive)
+void FloodFill::run(Board &board, int maxWork, RevealDelta &revealed)
+{
+    const int *neighborOffsets = board.neighborOffsets();
+    int stride = board.rowStride();
+    int work = 0;
+    while (maxWork <= 0 || work < maxWork) {
+        if (!m_around.isEmpty()) {
+            int cell = m_around.takeLast();
+            for (int i = 0; i < Board::NumNeighbors; i++) {
+                int neighbor = cell + neighborOffsets[i];
+                revealCell(board, neighbor, revealed);
+                if (isExpandable(board, neighbor)) {
+                    m_seeds.append(neighbor);
+                }
+            }
+            work += 9;
+            continue;
+        }
+        if (m_seeds.isEmpty()) {
+            break;
+        }
+
+        int cell = m_seeds.takeLast();
+        if (!isExpandable(board, cell)) {
+            continue;
+        }
+
+        // Openings without flags in them are revealed whole, from the
+        // board's labelling
+        int opening = board.openingAt(board.rowOf(cell), board.colOf(cell));
+        if (m_openingsRevealed.contains(opening)) {
+            continue;
+        }
+        if (opening >= 0 && !board.openingHasFlags(opening)) {
+            int numRevealed = revealed.size();
+            board.revealOpening(opening, revealed);
+            m_openingsRevealed.insert(opening);
+            work += revealed.size() - numRevealed + 1;
+            continue;
+        }
+
+        // Extend the span as far as it goes in both directions
+        int left = cell;
+        while (isExpandable(board, left - 1)) {
+            left--;
+        }
+        int right = cell;
+        while (isExpandable(board, right + 1)) {
+            right++;
+        }
+        for (int j = left; j <= right; j++) {
+            setBit(m_expanded, j);
+        }
+
+        // Reveal the span and everything touching it
+        for (int offset = -stride; offset <= stride; offset += stride) {
+            for (int j = left - 1; j <= right + 1; j++) {
+                revealCell(board, offset + j, revealed);
+            }
+        }
+
+        // Start a span from each run of empty cells in the rows above and below
+        for (int offset = -stride; offset <= stride; offset += 2 * stride) {
+            bool inRun = false;
+            for (int j = left - 1; j <= right + 1; j++) {
+                bool expandable = isExpandable(board, offset + j);
+                if (expandable && !inRun) {
+                    m_seeds.append(offset + j);
+                }
+                inRun = expandable;
+            }
+        }
+        work += 3 * (right - left + 3);
+    }
+}
+
+// Can this cell extend a span? It must have no surrounding mines, not be
+// flagged, not have been expanded, and not have been cleared before the
+// fill reached it (its neighbors were revealed back then). Sentinels are
+// cleared, so never expandable.
+bool FloodFill::isExpandable(const Board &board, int cell) const
+{
+    if (testBit(m_expanded, cell) || !board.zeroCountAt(cell)
+            || board.mineAt(cell) || board.flaggedAt(cell)) {
+        return false;
+    }
+    return testBit(m_revealed, cell) || !board.clearedAt(cell);
+}
+
+// Clear a cell unless it's flagged or already cleared
+void FloodFill::revealCell(Board &board, int cell, RevealDelta &revealed)
+{
+    if (board.clearedAt(cell) || board.flaggedAt(cell)) {
+        return;
+    }
+    board.clearCellAt(cell);
+    setBit(m_revealed, cell);
+
+    RevealedCell revealedCell;
+    revealedCell.row = board.rowOf(cell);
+    revealedCell.col = board.colOf(cell);
+    revealedCell.count = static_cast<quint8>(board.countAt(cell));
+    revealedCell.hasMine = board.mineAt(cell);
+    revealed.append(revealedCell);
+}
+
+bool FloodFill::testBit(const QVector<quint64> &bits, int index) const
+{
+    return (bits[index / 64] >> (index % 64)) & 1;
+}
+
+void FloodFill::setBit(QVector<quint64> &bits, int index)
+{
+    bits[index / 64] |= quint64(1) << (index % 64);
+}
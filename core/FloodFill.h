@@ -0,0 +1,54 @@
+#ifndef FLOODFILL_H
+#define FLOODFILL_H
+
+#include "Board.h"
+#include "RevealDelta.h"
+#include <QSet>
+#include <QVector>
+
+// Reveals openings: the cells around a cell, and everything connected to
+// them through cells with no surrounding mines
+//
+// Openings the board has labelled are revealed whole, with one OR per
+// bit-plane word. Openings with flagged cells in them are filled instead,
+// since a flag stops the opening from spreading past it.
+//
+// Fills work a horizontal run (span) of empty cells at a time rather than one
+// cell at a time. Each cell is expanded at most once, tracked in a
+// visited bitmap, and only cells revealed by the fill itself are
+// expanded, so cells cleared earlier in the game are never rescanned.
+//
+// Cells are handled by their board cell index. The board's sentinel
+// border is cleared, so it stops spans and is never revealed, and the
+// fill never has to check that a cell is on the board.
+//
+// The fill can stop after a given amount of work and pick up where it
+// left off, so that a huge opening can be revealed a slice at a time.
+
+class FloodFill
+{
+public:
+    void reset(const Board &board);
+    void revealAround(int cell);
+    bool isFinished() const;
+    void run(Board &board, int maxWork, RevealDelta &revealed);
+
+private:
+    bool isExpandable(const Board &board, int cell) const;
+    void revealCell(Board &board, int cell, RevealDelta &revealed);
+    bool testBit(const QVector<quint64> &bits, int index) const;
+    void setBit(QVector<quint64> &bits, int index);
+
+private:
+    // Cells whose neighbors must all be revealed
+    QVector<int> m_around;
+    // Empty cells to start spans from
+    QVector<int> m_seeds;
+    // Cells revealed by the fill, and empty cells already expanded
+    QVector<quint64> m_revealed;
+    QVector<quint64> m_expanded;
+    // Openings already revealed whole
+    QSet<int> m_openingsRevealed;
+};
+
+#endif // FLOODFILL_H
@@ -0,0 +1,287 @@
+#include "GameEngine.h"
+
+GameEngine::GameEngine()
+{
+    m_listener = &m_nullListener;
+    m_sliceSize = 0;
+    m_state = Playing;
+    m_rows = 0;
+    m_cols = 0;
+    m_mines = 0;
+}
+
+// Set the listener told about game state changes
+void GameEngine::setListener(GameListener *listener)
+{
+    m_listener = listener ? listener : &m_nullListener;
+}
+
+// Start a game
+void GameEngine::startGame(int rows, int cols, int mines, quint64 seed)
+{
+    m_rows = rows;
+    m_cols = cols;
+    m_mines = mines;
+    m_state = Playing;
+    m_revealedCells.clear();
+
+    // Initialize board
+    m_board.initialize(m_rows, m_cols, m_mines, seed);
+    m_fill.reset(m_board);
+}
+
+// Start a game on a board that has already been generated
+void GameEngine::startGame(const Board &board)
+{
+    m_board = board;
+    m_rows = m_board.rows();
+    m_cols = m_board.cols();
+    m_mines = m_board.numMines();
+    m_state = Playing;
+    m_revealedCells.clear();
+    m_fill.reset(m_board);
+}
+
+// Reveal openings at most this many cells at a time (no limit if not positive)
+void GameEngine::setSliceSize(int cells)
+{
+    m_sliceSize = cells;
+}
+
+// Is an opening still being revealed?
+bool GameEngine::hasPendingWork() const
+{
+    return m_state == Playing && !m_fill.isFinished();
+}
+
+// Reveal the next slice of an opening
+void GameEngine::continueWork()
+{
+    if (hasPendingWork()) {
+        runFill();
+        flushRevealedCells();
+    }
+}
+
+// Current state of the game
+GameEngine::State GameEngine::state() const
+{
+    return m_state;
+}
+
+// Internal representation of the board
+Board &GameEngine::board()
+{
+    return m_board;
+}
+
+// Do row and col designate a valid cell?
+bool GameEngine::isValidCell(int row, int col)
+{
+    // Make sure row and col are within bounds
+    if (row < 0 || row >= m_rows) {
+        return false;
+    }
+    if (col < 0 || col >= m_cols) {
+        return false;
+    }
+
+    return true;
+}
+
+// Called when the player clicks a cell
+void GameEngine::cellClicked(int row, int col)
+{
+    bool clearSurrounding = false;
+
+    // Ignore clicks once the game is over, and clicks off the board
+    if (m_state != Playing || !isValidCell(row, col)) {
+        return;
+    }
+
+    // Don't let player accidentally click flagged cells
+    if (m_board.isFlagged(row, col)) {
+        return;
+    }
+
+    // If this cell has not been cleared already
+    if (!m_board.isCleared(row, col)) {
+        clearCell(row, col);
+        // Check if the player cleared a mine
+        if (m_board.mineTriggered()) {
+            doGameLost();
+            return;
+        }
+        // If this cell has no surrounding mines, clear all cells around it
+        if (m_board.mineCount(row, col) == 0) {
+            clearSurrounding = true;
+        }
+    } else {
+        // If player clicks a cell that has already been cleared AND the player has flagged the correct
+        // number of cells around it, clear all surrounding non-flagged cells
+        if (m_board.numSurroundingFlags(row, col) == m_board.mineCount(row, col)) {
+            clearSurrounding = true;
+        }
+    }
+
+    if (clearSurrounding) {
+        clearNeighboringCells(row, col);
+    }
+
+    flushRevealedCells();
+}
+
+// Called when the player flags or unflags a cell
+void GameEngine::cellFlagged(int row, int col)
+{
+    if (m_state != Playing || !isValidCell(row, col)) {
+        return;
+    }
+
+    // Toggle flag for this cell
+    if (!m_board.isCleared(row, col)) {
+        m_board.toggleFlag(row, col);
+        m_listener->setCellFlagged(row, col, m_board.isFlagged(row, col));
+    }
+}
+
+// Clear a cell, revealing its contents
+void GameEngine::clearCell(int row, int col)
+{
+    // Clear this cell
+    m_board.clearCell(row, col);
+    addRevealedCell(row, col);
+
+    // If this cell is a mine, game is over
+    if (m_board.hasMine(row, col)) {
+        flushRevealedCells();
+        m_listener->explode(row, col);
+    }
+
+    if (m_board.allCellsCleared()) {
+        // Player wins
+        doGameWon();
+    }
+}
+
+// Remember a cleared cell so the listener can be told about it
+void GameEngine::addRevealedCell(int row, int col)
+{
+    RevealedCell cell;
+    cell.row = row;
+    cell.col = col;
+    cell.count = static_cast<quint8>(m_board.mineCount(row, col));
+    cell.hasMine = m_board.hasMine(row, col);
+    m_revealedCells.append(cell);
+}
+
+// Report the cells cleared so far as a single update, or in slices if a
+// slice size is set
+void GameEngine::flushRevealedCells()
+{
+    if (m_revealedCells.isEmpty()) {
+        return;
+    }
+    if (m_sliceSize <= 0 || m_revealedCells.size() <= m_sliceSize) {
+        m_listener->cellsCleared(m_revealedCells);
+    } else {
+        for (int first = 0; first < m_revealedCells.size(); first += m_sliceSize) {
+            m_listener->cellsCleared(m_revealedCells.mid(first, m_sliceSize));
+        }
+    }
+    m_revealedCells.clear();
+}
+
+// Clear all the neighbors around a cell, either because the player has cleared
+// a cell with no surrounding mines, or because player has flagged the correct
+// number of surrounding cells and wants to clear all of the non-flagged cells
+void GameEngine::clearNeighboringCells(int row, int col)
+{
+    m_fill.revealAround(m_board.cellIndex(row, col));
+    runFill();
+}
+
+// Reveal queued openings, one slice of them if a slice size is set
+void GameEngine::runFill()
+{
+    // Clearing the cell itself may already have won the game
+    if (m_state != Playing) {
+        return;
+    }
+
+    int firstCell = m_revealedCells.size();
+    m_fill.run(m_board, m_sliceSize, m_revealedCells);
+
+    // Only the cells around a chorded cell can be mines; openings never are
+    if (m_board.mineTriggered()) {
+        QVector<RevealedCell> mines;
+        for (int i = firstCell; i < m_revealedCells.size(); i++) {
+            if (m_revealedCells[i].hasMine) {
+                mines.append(m_revealedCells[i]);
+            }
+        }
+        flushRevealedCells();
+        for (const RevealedCell &mine : mines) {
+            m_listener->explode(mine.row, mine.col);
+        }
+        doGameLost();
+        return;
+    }
+
+    if (m_board.allCellsCleared()) {
+        // Player wins
+        doGameWon();
+    }
+}
+
+// Clear all cells after the game has been lost
+void GameEngine::clearAllCells()
+{
+    for (int row = 0; row < m_rows; row++) {
+        for (int col = 0; col < m_cols; col++) {
+            if (!m_board.isCleared(row, col)) {
+                // Clear non-flagged cells
+                if (!m_board.isFlagged(row, col)) {
+                    m_board.clearCell(row, col);
+                    addRevealedCell(row, col);
+                }
+                // Mark incorrectly flagged cells
+                if (m_board.isFlagged(row, col) && !m_board.hasMine(row, col)) {
+                    m_listener->markIncorrectlyFlaggedCell(row, col);
+                }
+            }
+        }
+    }
+    flushRevealedCells();
+}
+
+// Called after winning the game to flag mines that were not flagged by the player
+void GameEngine::flagAllBombs()
+{
+    for (int row = 0; row < m_rows; row++) {
+        for (int col = 0; col < m_cols; col++) {
+            // Flag unflagged mines
+            if (!m_board.isFlagged(row, col) && m_board.hasMine(row, col)) {
+                m_listener->setCellFlagged(row, col, true);
+            }
+        }
+    }
+}
+
+// Player loses
+void GameEngine::doGameLost()
+{
+    m_state = Lost;
+    flushRevealedCells();
+    m_listener->gameLost();
+    clearAllCells();
+}
+
+// Player wins
+void GameEngine::doGameWon()
+{
+    m_state = Won;
+    flushRevealedCells();
+    m_listener->gameWon();
+    flagAllBombs();
+}
@@ -0,0 +1,66 @@
+#ifndef GAMEENGINE_H
+#define GAMEENGINE_H
+
+#include "Board.h"
+#include "FloodFill.h"
+#include "GameListener.h"
+
+// Game logic
+// Maintains the state of the board and determines the new game
+// state given player actions.
+// Has no UI or signal dependencies: changes are reported to an
+// optional GameListener, so the same engine drives the GUI and the
+// headless simulator.
+//
+// By default each action runs to completion. With a slice size set,
+// openings are revealed a slice at a time: an action does one slice,
+// and continueWork() does the next while hasPendingWork() is true.
+
+class GameEngine
+{
+public:
+    enum State {
+        Playing,
+        Won,
+        Lost
+    };
+
+    GameEngine();
+    void setListener(GameListener *listener);
+    void startGame(int rows, int cols, int mines, quint64 seed);
+    void startGame(const Board &board);
+    void cellClicked(int row, int col);
+    void cellFlagged(int row, int col);
+    void setSliceSize(int cells);
+    bool hasPendingWork() const;
+    void continueWork();
+    State state() const;
+    Board &board();
+
+private:
+    bool isValidCell(int row, int col);
+    void clearCell(int row, int col);
+    void addRevealedCell(int row, int col);
+    void flushRevealedCells();
+    void clearNeighboringCells(int row, int col);
+    void runFill();
+    void clearAllCells();
+    void flagAllBombs();
+    void doGameLost();
+    void doGameWon();
+
+private:
+    Board m_board;
+    FloodFill m_fill;
+    int m_sliceSize;
+    GameListener *m_listener;
+    GameListener m_nullListener;
+    State m_state;
+    int m_rows;
+    int m_cols;
+    int m_mines;
+    // Cells cleared by the current player action, not yet reported
+    RevealDelta m_revealedCells;
+};
+
+#endif // GAMEENGINE_H
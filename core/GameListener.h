@@ -0,0 +1,24 @@
+#ifndef GAMELISTENER_H
+#define GAMELISTENER_H
+
+#include "RevealDelta.h"
+
+// Receives the game state changes made by a GameEngine.
+//
+// The GUI forwards these to GameSignals; headless players such as the
+// simulator's bots use them to follow the game without a UI. Every
+// function has an empty default so listeners only override what they need.
+
+class GameListener
+{
+public:
+    virtual ~GameListener() {}
+    virtual void cellsCleared(const RevealDelta &cells) { Q_UNUSED(cells) }
+    virtual void setCellFlagged(int row, int col, bool flagged) { Q_UNUSED(row) Q_UNUSED(col) Q_UNUSED(flagged) }
+    virtual void explode(int row, int col) { Q_UNUSED(row) Q_UNUSED(col) }
+    virtual void markIncorrectlyFlaggedCell(int row, int col) { Q_UNUSED(row) Q_UNUSED(col) }
+    virtual void gameWon() {}
+    virtual void gameLost() {}
+};
+
+#endif // GAMELISTENER_H
@@ -0,0 +1,301 @@
+#include "GameRecord.h"
+#include <QFile>
+
+namespace {
+
+const char Magic[4] = { 'M', 'S', 'W', 'R' };
+const quint8 FormatVersion = 1;
+
+// Header flags
+const quint8 HasSafeCell = 0x01;
+const quint8 ListsMines = 0x02;
+
+// Bits of an action code holding its type
+const int TypeBits = 2;
+
+void appendVarint(QByteArray &data, quint64 value)
+{
+    while (value >= 0x80) {
+        data.append(char(quint8(value) | 0x80));
+        value >>= 7;
+    }
+    data.append(char(value));
+}
+
+bool readVarint(const uchar *&pos, const uchar *end, quint64 &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos == end) {
+            return false;
+        }
+        quint8 byte = *pos++;
+        value |= quint64(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+quint64 zigzag(qint64 value)
+{
+    return (quint64(value) << 1) ^ quint64(value >> 63);
+}
+
+qint64 unzigzag(quint64 value)
+{
+    return qint64(value >> 1) ^ -qint64(value & 1);
+}
+
+}
+
+GameRecord::GameRecord()
+{
+    m_rows = 0;
+    m_cols = 0;
+    m_numMines = 0;
+    m_seed = 0;
+    m_safeRow = -1;
+    m_safeCol = -1;
+}
+
+// Start recording a game on a board made from a seed, with a safe first
+// click if one was given. If the seed doesn't give the board, its mines
+// are kept instead.
+void GameRecord::start(const Board &board, quint64 seed, int safeRow, int safeCol)
+{
+    m_rows = board.rows();
+    m_cols = board.cols();
+    m_numMines = board.numMines();
+    m_seed = seed;
+    m_safeRow = safeRow;
+    m_safeCol = safeCol;
+    m_mines.clear();
+    m_actions.clear();
+
+    Board fromSeed;
+    fromSeed.initialize(m_rows, m_cols, m_numMines, m_seed, m_safeRow, m_safeCol);
+    bool sameMines = true;
+    for (int row = 0; row < m_rows && sameMines; row++) {
+        for (int col = 0; col < m_cols; col++) {
+            if (board.mineAt(board.cellIndex(row, col)) != fromSeed.hasMine(row, col)) {
+                sameMines = false;
+                break;
+            }
+        }
+    }
+    if (!sameMines) {
+        for (int row = 0; row < m_rows; row++) {
+            for (int col = 0; col < m_cols; col++) {
+                if (board.mineAt(board.cellIndex(row, col))) {
+                    m_mines.append(row * m_cols + col);
+                }
+            }
+        }
+    }
+}
+
+// Add an action, made a given number of milliseconds into the game
+void GameRecord::addAction(ActionType type, int row, int col, qint64 time)
+{
+    Action action = { type, row, col, time };
+    m_actions.append(action);
+}
+
+int GameRecord::rows() const
+{
+    return m_rows;
+}
+
+int GameRecord::cols() const
+{
+    return m_cols;
+}
+
+int GameRecord::numMines() const
+{
+    return m_numMines;
+}
+
+// The board the game was played on
+Board GameRecord::board() const
+{
+    Board board;
+    board.initialize(m_rows, m_cols, m_numMines, m_seed, m_safeRow, m_safeCol);
+    if (m_mines.isEmpty()) {
+        return board;
+    }
+
+    // Move the seeded mines onto the listed cells
+    QVector<bool> listed(m_rows * m_cols, false);
+    for (int cell : m_mines) {
+        listed[cell] = true;
+    }
+    QVector<int> from;
+    QVector<int> to;
+    for (int cell = 0; cell < m_rows * m_cols; cell++) {
+        bool hasMine = board.hasMine(cell / m_cols, cell % m_cols);
+        if (hasMine && !listed[cell]) {
+            from.append(cell);
+        } else if (!hasMine && listed[cell]) {
+            to.append(cell);
+        }
+    }
+    for (int i = 0; i < from.size() && i < to.size(); i++) {
+        board.moveMine(from[i] / m_cols, from[i] % m_cols, to[i] / m_cols, to[i] % m_cols);
+    }
+    return board;
+}
+
+// Every action, in the order they were made
+const QVector<GameRecord::Action> &GameRecord::actions() const
+{
+    return m_actions;
+}
+
+// Encode the record
+QByteArray GameRecord::save() const
+{
+    QByteArray data;
+    data.reserve(32 + 2 * m_mines.size() + 3 * m_actions.size());
+    data.append(Magic, sizeof(Magic));
+    data.append(char(FormatVersion));
+    quint8 flags = 0;
+    if (m_safeRow >= 0 && m_safeCol >= 0) {
+        flags |= HasSafeCell;
+    }
+    if (!m_mines.isEmpty()) {
+        flags |= ListsMines;
+    }
+    data.append(char(flags));
+
+    appendVarint(data, quint64(m_rows));
+    appendVarint(data, quint64(m_cols));
+    appendVarint(data, quint64(m_numMines));
+    appendVarint(data, m_seed);
+    if (flags & HasSafeCell) {
+        appendVarint(data, quint64(m_safeRow));
+        appendVarint(data, quint64(m_safeCol));
+    }
+    if (flags & ListsMines) {
+        int previous = -1;
+        for (int cell : m_mines) {
+            appendVarint(data, quint64(cell - previous - 1));
+            previous = cell;
+        }
+    }
+
+    appendVarint(data, quint64(m_actions.size()));
+    qint64 previousTime = 0;
+    qint64 previousCell = 0;
+    for (const Action &action : m_actions) {
+        qint64 cell = qint64(action.row) * m_cols + action.col;
+        appendVarint(data, quint64(qMax<qint64>(action.time - previousTime, 0)));
+        appendVarint(data, (zigzag(cell - previousCell) << TypeBits) | action.type);
+        previousTime = qMax(action.time, previousTime);
+        previousCell = cell;
+    }
+    return data;
+}
+
+// Decode a record. Returns false if the data isn't a valid record.
+bool GameRecord::load(const QByteArray &data)
+{
+    const uchar *pos = reinterpret_cast<const uchar *>(data.constData());
+    const uchar *end = pos + data.size();
+    if (data.size() < int(sizeof(Magic)) + 2 || !data.startsWith(QByteArray(Magic, sizeof(Magic)))
+            || quint8(data[sizeof(Magic)]) != FormatVersion) {
+        return false;
+    }
+    pos += sizeof(Magic) + 1;
+    quint8 flags = *pos++;
+
+    quint64 rows, cols, numMines, seed;
+    if (!readVarint(pos, end, rows) || !readVarint(pos, end, cols)
+            || !readVarint(pos, end, numMines) || !readVarint(pos, end, seed)) {
+        return false;
+    }
+    // Cells must be indexable, and rows * cols must fit an int
+    if (!Board::isValidSize(rows, cols) || numMines > rows * cols) {
+        return false;
+    }
+    m_rows = int(rows);
+    m_cols = int(cols);
+    m_numMines = int(numMines);
+    m_seed = seed;
+
+    m_safeRow = -1;
+    m_safeCol = -1;
+    if (flags & HasSafeCell) {
+        quint64 safeRow, safeCol;
+        if (!readVarint(pos, end, safeRow) || !readVarint(pos, end, safeCol)
+                || safeRow >= rows || safeCol >= cols) {
+            return false;
+        }
+        m_safeRow = int(safeRow);
+        m_safeCol = int(safeCol);
+    }
+
+    m_mines.clear();
+    if (flags & ListsMines) {
+        m_mines.reserve(m_numMines);
+        qint64 cell = -1;
+        for (int i = 0; i < m_numMines; i++) {
+            quint64 gap;
+            if (!readVarint(pos, end, gap) || gap >= rows * cols) {
+                return false;
+            }
+            cell += qint64(gap) + 1;
+            if (cell >= qint64(rows * cols)) {
+                return false;
+            }
+            m_mines.append(int(cell));
+        }
+    }
+
+    quint64 numActions;
+    if (!readVarint(pos, end, numActions) || numActions > quint64(end - pos)) {
+        return false;
+    }
+    m_actions.clear();
+    m_actions.reserve(int(numActions));
+    qint64 time = 0;
+    qint64 cell = 0;
+    for (quint64 i = 0; i < numActions; i++) {
+        quint64 delay, code;
+        if (!readVarint(pos, end, delay) || !readVarint(pos, end, code)) {
+            return false;
+        }
+        time += qint64(delay);
+        cell += unzigzag(code >> TypeBits);
+        int type = int(code & ((1 << TypeBits) - 1));
+        if (type > Chord || cell < 0 || cell >= qint64(rows * cols)) {
+            return false;
+        }
+        Action action = { ActionType(type), int(cell / m_cols), int(cell % m_cols), time };
+        m_actions.append(action);
+    }
+    return pos == end;
+}
+
+// Write the record to a file
+bool GameRecord::saveToFile(const QString &path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QByteArray data = save();
+    return file.write(data) == data.size();
+}
+
+// Read a record from a file
+bool GameRecord::loadFromFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return load(file.readAll());
+}
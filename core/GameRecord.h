@@ -0,0 +1,65 @@
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include "Board.h"
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+// What happened in one game: the board it was played on and every
+// click, flag and chord, with the time it was made
+//
+// Records are saved in a compact binary form. The header holds the
+// board size, mine count and seed; when the seed (and the first click
+// kept clear of mines) doesn't reproduce the board, as for no-guess
+// boards, the mines are listed too, as gaps between mine cells. Each
+// action is then two varints: the milliseconds since the previous
+// action, and the action type packed with the change in cell index from
+// the previous action (zigzag encoded). A bot game with clicks close
+// together takes two or three bytes an action.
+
+class GameRecord
+{
+public:
+    enum ActionType {
+        Click,
+        Flag,
+        // A click on a cleared count, clearing around it
+        Chord
+    };
+
+    struct Action
+    {
+        ActionType type;
+        int row;
+        int col;
+        // Milliseconds since the game started
+        qint64 time;
+    };
+
+    GameRecord();
+    void start(const Board &board, quint64 seed, int safeRow = -1, int safeCol = -1);
+    void addAction(ActionType type, int row, int col, qint64 time);
+    int rows() const;
+    int cols() const;
+    int numMines() const;
+    Board board() const;
+    const QVector<Action> &actions() const;
+    QByteArray save() const;
+    bool load(const QByteArray &data);
+    bool saveToFile(const QString &path) const;
+    bool loadFromFile(const QString &path);
+
+private:
+    int m_rows;
+    int m_cols;
+    int m_numMines;
+    quint64 m_seed;
+    int m_safeRow;
+    int m_safeCol;
+    // Mine cells, as row * cols + col, when the seed doesn't give the board
+    QVector<int> m_mines;
+    QVector<Action> m_actions;
+};
+
+#endif // GAMERECORD_H
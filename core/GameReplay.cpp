@@ -0,0 +1,76 @@
+#include "GameReplay.h"
+
+GameReplay::GameReplay()
+{
+    m_next = 0;
+}
+
+// Set the listener told about game state changes
+void GameReplay::setListener(GameListener *listener)
+{
+    m_engine.setListener(listener);
+}
+
+// Start playing a record back from its first action
+void GameReplay::start(const GameRecord &record)
+{
+    m_actions = record.actions();
+    m_next = 0;
+    m_engine.startGame(record.board());
+}
+
+// Have all the actions been applied?
+bool GameReplay::atEnd() const
+{
+    return m_next >= m_actions.size();
+}
+
+// Number of actions applied so far
+int GameReplay::position() const
+{
+    return m_next;
+}
+
+// Time of the next action, in milliseconds since the game started
+qint64 GameReplay::nextActionTime() const
+{
+    return atEnd() ? -1 : m_actions[m_next].time;
+}
+
+// Apply the next action
+void GameReplay::step()
+{
+    if (atEnd()) {
+        return;
+    }
+    const GameRecord::Action &action = m_actions[m_next++];
+    if (action.type == GameRecord::Flag) {
+        m_engine.cellFlagged(action.row, action.col);
+    } else {
+        // Clicks and chords are both clicks to the engine
+        m_engine.cellClicked(action.row, action.col);
+    }
+}
+
+// Apply every action made up to a time, in milliseconds since the game
+// started
+void GameReplay::runUntil(qint64 time)
+{
+    while (!atEnd() && m_actions[m_next].time <= time) {
+        step();
+    }
+}
+
+// Apply every action that is left
+void GameReplay::runToEnd()
+{
+    while (!atEnd()) {
+        step();
+    }
+}
+
+// The engine the record is played on
+GameEngine &GameReplay::engine()
+{
+    return m_engine;
+}
@@ -0,0 +1,35 @@
+#ifndef GAMEREPLAY_H
+#define GAMEREPLAY_H
+
+#include "GameEngine.h"
+#include "GameRecord.h"
+
+// Plays a GameRecord back on a GameEngine
+//
+// Actions are applied in order, each running to completion, and the
+// engine reports what they change to its listener as in a live game.
+// Headless, with no listener, a replay runs as fast as the engine can
+// apply the actions; runUntil() lets a caller follow the record's own
+// timing, a frame at a time.
+
+class GameReplay
+{
+public:
+    GameReplay();
+    void setListener(GameListener *listener);
+    void start(const GameRecord &record);
+    bool atEnd() const;
+    int position() const;
+    qint64 nextActionTime() const;
+    void step();
+    void runUntil(qint64 time);
+    void runToEnd();
+    GameEngine &engine();
+
+private:
+    GameEngine m_engine;
+    QVector<GameRecord::Action> m_actions;
+    int m_next;
+};
+
+#endif // GAMEREPLAY_H
@@ -0,0 +1,274 @@
+#include "NoGuessGenerator.h"
+#include "GameEngine.h"
+#include "Solver.h"
+#include <QAtomicInt>
+#include <QFuture>
+#include <QMutex>
+#include <QVector>
+#include <QtConcurrent>
+
+namespace {
+
+// Give up on a board after this many attempts
+const int MaxAttempts = 256;
+
+// Random picks to try when looking for somewhere to move a mine
+const int MaxTargetTries = 64;
+
+// The board being asked for
+struct Request
+{
+    int rows;
+    int cols;
+    int mines;
+    int row;
+    int col;
+    quint64 seed;
+    // Set by another thread to give up early, or null
+    const QAtomicInt *cancel;
+};
+
+// State shared by the workers of one generate() call
+struct Search
+{
+    QAtomicInt nextAttempt;
+    QAtomicInt bestAttempt;
+    QMutex mutex;
+    Board board;
+};
+
+// Feeds everything the engine reveals to a solver
+class SolverListener : public GameListener
+{
+public:
+    explicit SolverListener(Solver *solver) : m_solver(solver) {}
+    void cellsCleared(const RevealDelta &cells) override { m_solver->cellsCleared(cells); }
+
+private:
+    Solver *m_solver;
+};
+
+// Is any neighbor of this cell revealed?
+bool isNextToRevealed(const Solver &solver, int row, int col)
+{
+    for (int i = qMax(row - 1, 0); i <= qMin(row + 1, solver.rows() - 1); i++) {
+        for (int j = qMax(col - 1, 0); j <= qMin(col + 1, solver.cols() - 1); j++) {
+            if (solver.cellState(i, j) == Solver::Revealed) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Has the caller asked for generation to stop?
+bool isCancelled(const Request &request)
+{
+    return request.cancel && request.cancel->loadAcquire();
+}
+
+// One of the mines the solver is stuck on, at random, or -1 if it isn't
+// stuck next to any
+int stuckMine(Board &board, const Solver &solver, Random &random)
+{
+    int cols = solver.cols();
+    QVector<int> stuckMines;
+    for (int index : solver.frontier()) {
+        int neighbors[8];
+        int minesLeft;
+        int numNeighbors = solver.unknownNeighbors(index, neighbors, minesLeft);
+        for (int i = 0; i < numNeighbors; i++) {
+            if (board.hasMine(neighbors[i] / cols, neighbors[i] % cols)) {
+                stuckMines.append(neighbors[i]);
+            }
+        }
+    }
+    if (stuckMines.isEmpty()) {
+        return -1;
+    }
+    return stuckMines[static_cast<int>(random.bounded(stuckMines.size()))];
+}
+
+// An unknown cell with no mine for a stuck mine to move to, or -1 if none
+// turns up. Cells no revealed count can see are best, since the mine
+// then adds nothing new to work out; failing that, any unknown cell will
+// do, which is all there is near the end of the game.
+int targetCell(Board &board, const Solver &solver, Random &random)
+{
+    int cols = solver.cols();
+    int numUnknown = solver.numUnknownCells();
+    int fallback = -1;
+    for (int i = 0; i < MaxTargetTries; i++) {
+        int cell = solver.unknownCell(static_cast<int>(random.bounded(numUnknown)));
+        if (board.hasMine(cell / cols, cell % cols)) {
+            continue;
+        }
+        if (!isNextToRevealed(solver, cell / cols, cell % cols)) {
+            return cell;
+        }
+        if (fallback < 0) {
+            fallback = cell;
+        }
+    }
+    return fallback;
+}
+
+// Add the revealed cells around a cell to the counts a move changed
+void addCountsAround(Board &board, const Solver &solver, int index, RevealDelta &changed)
+{
+    int row = index / solver.cols();
+    int col = index % solver.cols();
+    for (int i = qMax(row - 1, 0); i <= qMin(row + 1, solver.rows() - 1); i++) {
+        for (int j = qMax(col - 1, 0); j <= qMin(col + 1, solver.cols() - 1); j++) {
+            if (solver.cellState(i, j) == Solver::Revealed) {
+                RevealedCell cell;
+                cell.row = i;
+                cell.col = j;
+                cell.count = static_cast<quint8>(board.mineCount(i, j));
+                cell.hasMine = false;
+                changed.append(cell);
+            }
+        }
+    }
+}
+
+// Move a mine the solver is stuck on to another unknown cell, on the
+// board and in the game being played on it
+//
+// The game carries on from where it was. Nothing had been deduced about
+// either cell, so all the solver knows still holds, and only the counts
+// around the two cells change.
+void moveUnknownMine(Board &board, GameEngine &engine, Solver &solver, int from, int to)
+{
+    int cols = solver.cols();
+    board.moveMine(from / cols, from % cols, to / cols, to % cols);
+    Board &played = engine.board();
+    played.moveMine(from / cols, from % cols, to / cols, to % cols);
+
+    RevealDelta changed;
+    addCountsAround(played, solver, from, changed);
+    addCountsAround(played, solver, to, changed);
+    solver.countsChanged(changed);
+}
+
+// Play on with the solver until it wins, loses or gets stuck
+void playSafeCells(GameEngine &engine, Solver &solver)
+{
+    int row, col;
+    while (engine.state() == GameEngine::Playing && solver.nextSafeCell(row, col)) {
+        engine.cellClicked(row, col);
+    }
+}
+
+// Generate one board from a seed and play it with the solver from the
+// first click, repairing it whenever the solver gets stuck by moving a
+// mine it is stuck on somewhere else
+//
+// Repairs are made to the game in progress, so each one costs only what
+// it changes. A solver that saw the repaired board from the start might
+// not make the same deductions, though, so once a game with repairs is
+// won, the board is played again from the first click to check it, and
+// any repairs that needs are made in the same way.
+bool tryAttempt(const Request &request, quint64 seed, Board &board)
+{
+    board.initialize(request.rows, request.cols, request.mines, seed, request.row, request.col);
+
+    Solver solver;
+    SolverListener listener(&solver);
+    GameEngine engine;
+    engine.setListener(&listener);
+    // Use a different stream from the one that placed the mines
+    Random random(~seed);
+    int maxRepairs = 16 + request.rows * request.cols / 8;
+
+    int repair = 0;
+    while (true) {
+        engine.startGame(board);
+        solver.reset(request.rows, request.cols, board.numMines());
+        engine.cellClicked(request.row, request.col);
+        int firstRepair = repair;
+        playSafeCells(engine, solver);
+        while (engine.state() == GameEngine::Playing) {
+            int from = stuckMine(board, solver, random);
+            int to = targetCell(board, solver, random);
+            if (repair == maxRepairs || isCancelled(request) || from < 0 || to < 0) {
+                return false;
+            }
+            moveUnknownMine(board, engine, solver, from, to);
+            repair++;
+            playSafeCells(engine, solver);
+        }
+        if (engine.state() == GameEngine::Lost) {
+            return false;
+        }
+        if (repair == firstRepair) {
+            return true;
+        }
+    }
+}
+
+// Claim attempts until one succeeds. Workers keep going while a lower
+// attempt than the best success so far might still succeed.
+void runAttempts(const Request *request, Search *search)
+{
+    while (true) {
+        int attempt = search->nextAttempt.fetchAndAddRelaxed(1);
+        if (attempt >= search->bestAttempt.loadAcquire() || isCancelled(*request)) {
+            return;
+        }
+        Board board;
+        if (!tryAttempt(*request, request->seed + static_cast<quint64>(attempt), board)) {
+            continue;
+        }
+        QMutexLocker locker(&search->mutex);
+        if (attempt < search->bestAttempt.loadAcquire()) {
+            search->board = board;
+            search->bestAttempt.storeRelease(attempt);
+        }
+    }
+}
+
+}
+
+const int NoGuessGenerator::MaxMinePercent;
+
+NoGuessGenerator::NoGuessGenerator()
+{
+}
+
+// Is the board sparse enough for no-guess generation to be tried?
+bool NoGuessGenerator::canGenerate(int rows, int cols, int mines)
+{
+    return qint64(mines) * 100 <= qint64(rows) * cols * MaxMinePercent;
+}
+
+// Generate a board that the solver can clear without guessing, starting
+// by clicking (row, col). Returns false if the board is too dense to try,
+// if no attempt succeeded, or if cancel was set first. Workers
+// check cancel between attempts and between repairs, so setting it from
+// another thread makes this return soon after.
+bool NoGuessGenerator::generate(int rows, int cols, int mines, int row, int col,
+                                quint64 seed, Board &board, const QAtomicInt *cancel)
+{
+    if (!canGenerate(rows, cols, mines)) {
+        return false;
+    }
+    Request request = { rows, cols, mines, row, col, seed, cancel };
+    Search search;
+    search.nextAttempt.storeRelease(0);
+    search.bestAttempt.storeRelease(MaxAttempts);
+
+    QVector<QFuture<void>> workers;
+    for (int thread = 0; thread < m_pool.maxThreadCount(); thread++) {
+        workers.append(QtConcurrent::run(&m_pool, runAttempts, &request, &search));
+    }
+    for (QFuture<void> &worker : workers) {
+        worker.waitForFinished();
+    }
+
+    if (search.bestAttempt.loadAcquire() >= MaxAttempts) {
+        return false;
+    }
+    board = search.board;
+    return true;
+}
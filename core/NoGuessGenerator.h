@@ -0,0 +1,39 @@
+#ifndef NOGUESSGENERATOR_H
+#define NOGUESSGENERATOR_H
+
+#include "Board.h"
+#include <QAtomicInt>
+#include <QThreadPool>
+
+// Generates boards that can be solved without guessing
+//
+// The first click is given, and no mines are placed on or around it.
+// Each attempt places mines at random and plays the board with the
+// Solver. When the solver gets stuck, a mine on the stuck frontier is
+// moved somewhere the solver knows nothing about and play carries on,
+// so that large boards don't have to come out right all at once. A board
+// that needed repairs is played once more from the start to check it.
+//
+// Boards with more than MaxMinePercent mines aren't attempted: above
+// that, attempts mostly fail, and a large board can take minutes to give
+// up. At or below it, a 500 x 500 board takes a few seconds on one core.
+//
+// Attempts run speculatively on a pool of worker threads. Attempt n uses
+// seed + n, and the lowest-numbered attempt that succeeds is returned,
+// so the result depends only on the arguments, not on thread timing.
+
+class NoGuessGenerator
+{
+public:
+    static const int MaxMinePercent = 25;
+
+    NoGuessGenerator();
+    static bool canGenerate(int rows, int cols, int mines);
+    bool generate(int rows, int cols, int mines, int row, int col, quint64 seed, Board &board,
+                  const QAtomicInt *cancel = nullptr);
+
+private:
+    QThreadPool m_pool;
+};
+
+#endif // NOGUESSGENERATOR_H
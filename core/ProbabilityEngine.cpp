@@ -0,0 +1,500 @@
+#include "ProbabilityEngine.h"
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Components needing more partial states than this in one step are
+// estimated from their constraints instead of counted exactly
+const int MaxStates = 1 << 16;
+
+// Components with fewer cells than this are solved on the calling thread,
+// since handing them to another would take longer than solving them
+const int MinParallelCells = 32;
+
+// Partial solutions in one step of the dynamic program: the mines still
+// needed by every constraint, mapped to the number of ways of reaching
+// that state, by number of mines used so far
+typedef QHash<QByteArray, QVector<double>> Layer;
+
+// Add b, shifted by offset mines, into a
+void addShifted(QVector<double> &a, const QVector<double> &b, int offset)
+{
+    if (a.size() < b.size() + offset) {
+        a.resize(b.size() + offset);
+    }
+    for (int i = 0; i < b.size(); i++) {
+        a[i + offset] += b[i];
+    }
+}
+
+// Ways of placing mines in two independent sets of cells, by total mines
+QVector<double> convolve(const QVector<double> &a, const QVector<double> &b)
+{
+    QVector<double> result(a.size() + b.size() - 1, 0.0);
+    for (int i = 0; i < a.size(); i++) {
+        if (a[i] == 0) {
+            continue;
+        }
+        for (int j = 0; j < b.size(); j++) {
+            result[i + j] += a[i] * b[j];
+        }
+    }
+    return result;
+}
+
+// Apply one cell's assignment (0 or 1 mines) to a state. Fails if a
+// constraint would need a negative number of mines, or more mines than
+// it has cells left to place them in.
+bool applyCell(QByteArray &state, const QVector<QPair<int, int>> &constraints, int mine)
+{
+    for (const QPair<int, int> &constraint : constraints) {
+        int needed = state[constraint.first] - mine;
+        if (needed < 0 || needed > constraint.second) {
+            return false;
+        }
+        state[constraint.first] = static_cast<char>(needed);
+    }
+    return true;
+}
+
+}
+
+ProbabilityEngine::ProbabilityEngine()
+{
+    m_cols = 0;
+    m_parallel = true;
+    m_interiorProbability = 0;
+}
+
+// Forget cached results, e.g. when a new game starts
+void ProbabilityEngine::clear()
+{
+    m_cache.clear();
+    m_probabilities.clear();
+    m_estimated.clear();
+    m_interiorProbability = 0;
+}
+
+// Choose whether large components are solved in parallel on the global
+// thread pool. Callers that already run an engine on each of their own
+// threads should turn this off.
+void ProbabilityEngine::setParallel(bool parallel)
+{
+    m_parallel = parallel;
+}
+
+// Compute the probabilities for the solver's current knowledge
+void ProbabilityEngine::compute(const Solver &solver)
+{
+    m_cols = solver.cols();
+    m_probabilities.clear();
+    m_estimated.clear();
+
+    // Collect the constraints, numbering the unknown cells they touch
+    QVector<QVector<int>> constraints;
+    QVector<int> constraintMines;
+    QHash<int, int> cellIds;
+    QVector<int> cells;
+    for (int index : solver.frontier()) {
+        int neighbors[8];
+        int minesLeft;
+        int numNeighbors = solver.unknownNeighbors(index, neighbors, minesLeft);
+        if (numNeighbors == 0) {
+            continue;
+        }
+        QVector<int> constraint;
+        for (int i = 0; i < numNeighbors; i++) {
+            int id = cellIds.value(neighbors[i], -1);
+            if (id < 0) {
+                id = cells.size();
+                cellIds.insert(neighbors[i], id);
+                cells.append(neighbors[i]);
+            }
+            constraint.append(id);
+        }
+        constraints.append(constraint);
+        constraintMines.append(minesLeft);
+    }
+
+    // Join cells that share a constraint (union-find with path halving)
+    QVector<int> parent(cells.size());
+    for (int id = 0; id < cells.size(); id++) {
+        parent[id] = id;
+    }
+    auto find = [&parent](int id) {
+        while (parent[id] != id) {
+            parent[id] = parent[parent[id]];
+            id = parent[id];
+        }
+        return id;
+    };
+    for (const QVector<int> &constraint : constraints) {
+        for (int i = 1; i < constraint.size(); i++) {
+            parent[find(constraint[i])] = find(constraint[0]);
+        }
+    }
+
+    // Split cells and constraints into components
+    QHash<int, int> componentOfRoot;
+    QVector<Component> components;
+    for (int id = 0; id < cells.size(); id++) {
+        int root = find(id);
+        if (!componentOfRoot.contains(root)) {
+            componentOfRoot.insert(root, components.size());
+            components.append(Component());
+        }
+        components[componentOfRoot.value(root)].cells.append(cells[id]);
+    }
+    for (int i = 0; i < constraints.size(); i++) {
+        Component &component = components[componentOfRoot.value(find(constraints[i][0]))];
+        QVector<int> constraintCells;
+        for (int id : constraints[i]) {
+            constraintCells.append(cells[id]);
+        }
+        std::sort(constraintCells.begin(), constraintCells.end());
+        component.constraints.append(constraintCells);
+        component.minesLeft.append(constraintMines[i]);
+    }
+
+    // Identify each component by its contents, in a canonical order,
+    // and reuse the result if it was solved for an earlier move
+    QHash<QByteArray, ComponentResult> cache;
+    QVector<Component> pending;
+    QVector<int> pendingIndex;
+    for (int c = 0; c < components.size(); c++) {
+        Component &component = components[c];
+        std::sort(component.cells.begin(), component.cells.end());
+        QVector<int> order(component.constraints.size());
+        for (int i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&component](int a, int b) {
+            if (component.constraints[a] != component.constraints[b]) {
+                return std::lexicographical_compare(
+                            component.constraints[a].begin(), component.constraints[a].end(),
+                            component.constraints[b].begin(), component.constraints[b].end());
+            }
+            return component.minesLeft[a] < component.minesLeft[b];
+        });
+        QVector<QVector<int>> sortedConstraints;
+        QVector<int> sortedMines;
+        QByteArray key;
+        for (int i : order) {
+            sortedConstraints.append(component.constraints[i]);
+            sortedMines.append(component.minesLeft[i]);
+            key.append(static_cast<char>(component.minesLeft[i]));
+            key.append(static_cast<char>(component.constraints[i].size()));
+            key.append(reinterpret_cast<const char *>(component.constraints[i].constData()),
+                       component.constraints[i].size() * static_cast<int>(sizeof(int)));
+        }
+        component.constraints = sortedConstraints;
+        component.minesLeft = sortedMines;
+        component.key = key;
+
+        auto cached = m_cache.constFind(key);
+        if (cached != m_cache.constEnd()) {
+            component.result = cached.value();
+            cache.insert(key, component.result);
+        } else if (!m_parallel || component.cells.size() < MinParallelCells) {
+            solveComponent(component);
+            cache.insert(key, component.result);
+        } else {
+            pending.append(component);
+            pendingIndex.append(c);
+        }
+    }
+
+    // Count solutions of the large new components, in parallel if there
+    // is more than one
+    if (pending.size() > 1) {
+        QtConcurrent::blockingMap(pending, &ProbabilityEngine::solveComponent);
+    } else if (!pending.isEmpty()) {
+        solveComponent(pending[0]);
+    }
+    for (int i = 0; i < pending.size(); i++) {
+        components[pendingIndex[i]].result = pending[i].result;
+        cache.insert(pending[i].key, pending[i].result);
+    }
+    // Only keep results that can still be reused
+    m_cache = cache;
+
+    // Components that were too large to count exactly use their estimates,
+    // and those mines are taken off the total shared by everything else
+    QVector<const ComponentResult *> results;
+    double estimatedMines = 0;
+    for (const Component &component : components) {
+        const ComponentResult &result = component.result;
+        if (result.exact) {
+            results.append(&result);
+        } else {
+            for (int i = 0; i < result.cells.size(); i++) {
+                double probability = result.mineWays[i][0];
+                m_probabilities.insert(result.cells[i], probability);
+                m_estimated.insert(result.cells[i]);
+                estimatedMines += probability;
+            }
+        }
+    }
+
+    int minesLeft = solver.mines() - solver.numKnownMines() - qRound(estimatedMines);
+    int numInterior = solver.numUnknownCells() - cells.size();
+    combine(results, minesLeft, numInterior);
+}
+
+// Combine component results with the mines left for the interior cells
+// (unknown cells not next to any revealed count). With t mines on the
+// frontier, the interior can hold the rest in C(numInterior, minesLeft - t)
+// ways, so each frontier total is weighted by that.
+void ProbabilityEngine::combine(const QVector<const ComponentResult *> &results,
+                                int minesLeft, int numInterior)
+{
+    // Ways for all components, and for all but one, by total frontier mines
+    int numResults = results.size();
+    QVector<QVector<double>> prefix(numResults + 1);
+    QVector<QVector<double>> suffix(numResults + 1);
+    prefix[0] = QVector<double>(1, 1.0);
+    suffix[numResults] = QVector<double>(1, 1.0);
+    for (int i = 0; i < numResults; i++) {
+        prefix[i + 1] = convolve(prefix[i], results[i]->ways);
+    }
+    for (int i = numResults - 1; i >= 0; i--) {
+        suffix[i] = convolve(results[i]->ways, suffix[i + 1]);
+    }
+    const QVector<double> &total = prefix[numResults];
+
+    // Interior weight for each frontier total, relative to the largest,
+    // using log-gamma to keep the binomials in range
+    QVector<double> weight(total.size(), 0.0);
+    double maxLogWeight = -HUGE_VAL;
+    QVector<double> logWeight(total.size(), -HUGE_VAL);
+    for (int t = 0; t < total.size(); t++) {
+        int interiorMines = minesLeft - t;
+        if (interiorMines < 0 || interiorMines > numInterior) {
+            continue;
+        }
+        logWeight[t] = std::lgamma(numInterior + 1.0) - std::lgamma(interiorMines + 1.0)
+                - std::lgamma(numInterior - interiorMines + 1.0);
+        maxLogWeight = qMax(maxLogWeight, logWeight[t]);
+    }
+    for (int t = 0; t < total.size(); t++) {
+        if (logWeight[t] > -HUGE_VAL) {
+            weight[t] = std::exp(logWeight[t] - maxLogWeight);
+        }
+    }
+
+    double denominator = 0;
+    double interiorMines = 0;
+    for (int t = 0; t < total.size(); t++) {
+        denominator += total[t] * weight[t];
+        interiorMines += total[t] * weight[t] * (minesLeft - t);
+    }
+    if (denominator <= 0) {
+        // No consistent solution; the board must have changed under us
+        m_interiorProbability = 0;
+        return;
+    }
+    m_interiorProbability = numInterior > 0 ? interiorMines / denominator / numInterior : 0;
+
+    // Each cell: solutions in which it is a mine, weighted by the
+    // solutions of every other component and of the interior
+    for (int i = 0; i < numResults; i++) {
+        const ComponentResult &result = *results[i];
+        QVector<double> others = convolve(prefix[i], suffix[i + 1]);
+        QVector<double> cellWeight(result.ways.size(), 0.0);
+        for (int k = 0; k < cellWeight.size(); k++) {
+            for (int t = 0; t < others.size() && k + t < weight.size(); t++) {
+                cellWeight[k] += others[t] * weight[k + t];
+            }
+        }
+        for (int j = 0; j < result.cells.size(); j++) {
+            const QVector<double> &mineWays = result.mineWays[j];
+            double ways = 0;
+            for (int k = 0; k < mineWays.size() && k < cellWeight.size(); k++) {
+                ways += mineWays[k] * cellWeight[k];
+            }
+            m_probabilities.insert(result.cells[j], ways / denominator);
+        }
+    }
+}
+
+// Count the mine placements of one component that satisfy all of its
+// constraints, and for each cell the placements in which it is a mine.
+//
+// Cells are assigned one at a time in breadth-first order, so that few
+// constraints are partly assigned at once. A forward pass counts the ways
+// of reaching each state (mines still needed per constraint); a backward
+// pass counts the ways of completing each state. Combining the two at
+// each cell gives its mine counts without enumerating placements.
+void ProbabilityEngine::solveComponent(Component &component)
+{
+    ComponentResult &result = component.result;
+    int numCells = component.cells.size();
+    int numConstraints = component.constraints.size();
+    result.cells = component.cells;
+    result.ways.clear();
+    result.mineWays = QVector<QVector<double>>(numCells);
+    result.exact = true;
+
+    // Constraints of each cell, by position in the component
+    QHash<int, int> position;
+    for (int i = 0; i < numCells; i++) {
+        position.insert(component.cells[i], i);
+    }
+    QVector<QVector<int>> cellConstraints(numCells);
+    for (int c = 0; c < numConstraints; c++) {
+        for (int cell : component.constraints[c]) {
+            cellConstraints[position.value(cell)].append(c);
+        }
+    }
+
+    // Breadth-first order through shared constraints
+    QVector<int> order;
+    QVector<bool> visited(numCells, false);
+    visited[0] = true;
+    order.append(0);
+    for (int next = 0; next < order.size(); next++) {
+        for (int c : cellConstraints[order[next]]) {
+            for (int cell : component.constraints[c]) {
+                int i = position.value(cell);
+                if (!visited[i]) {
+                    visited[i] = true;
+                    order.append(i);
+                }
+            }
+        }
+    }
+
+    // For each step, the constraints it touches and how many of their
+    // cells are still unassigned after it
+    QVector<int> unassigned(numConstraints);
+    for (int c = 0; c < numConstraints; c++) {
+        unassigned[c] = component.constraints[c].size();
+    }
+    QVector<QVector<QPair<int, int>>> stepConstraints(numCells);
+    for (int step = 0; step < numCells; step++) {
+        for (int c : cellConstraints[order[step]]) {
+            unassigned[c]--;
+            stepConstraints[step].append(qMakePair(c, unassigned[c]));
+        }
+    }
+
+    // Forward pass
+    QByteArray start(numConstraints, 0);
+    for (int c = 0; c < numConstraints; c++) {
+        start[c] = static_cast<char>(component.minesLeft[c]);
+    }
+    QVector<Layer> forward(numCells + 1);
+    forward[0].insert(start, QVector<double>(1, 1.0));
+    for (int step = 0; step < numCells && result.exact; step++) {
+        for (auto it = forward[step].constBegin(); it != forward[step].constEnd(); ++it) {
+            for (int mine = 0; mine <= 1; mine++) {
+                QByteArray state = it.key();
+                if (applyCell(state, stepConstraints[step], mine)) {
+                    addShifted(forward[step + 1][state], it.value(), mine);
+                }
+            }
+        }
+        if (forward[step + 1].size() > MaxStates) {
+            result.exact = false;
+        }
+    }
+
+    if (!result.exact) {
+        // Too many states: estimate each cell from the densest of its constraints
+        for (int i = 0; i < numCells; i++) {
+            double probability = 0;
+            for (int c : cellConstraints[i]) {
+                double density = static_cast<double>(component.minesLeft[c])
+                        / component.constraints[c].size();
+                probability = qMax(probability, density);
+            }
+            result.mineWays[i] = QVector<double>(1, probability);
+        }
+        return;
+    }
+
+    QByteArray end(numConstraints, 0);
+    result.ways = forward[numCells].value(end);
+    if (result.ways.isEmpty()) {
+        result.ways = QVector<double>(1, 0.0);
+    }
+
+    // Backward pass, combining with the forward counts at each step
+    Layer backward;
+    backward.insert(end, QVector<double>(1, 1.0));
+    for (int step = numCells - 1; step >= 0; step--) {
+        Layer previous;
+        QVector<double> &mineWays = result.mineWays[order[step]];
+        for (auto it = forward[step].constBegin(); it != forward[step].constEnd(); ++it) {
+            QVector<double> completions;
+            for (int mine = 0; mine <= 1; mine++) {
+                QByteArray state = it.key();
+                if (!applyCell(state, stepConstraints[step], mine)) {
+                    continue;
+                }
+                auto next = backward.constFind(state);
+                if (next == backward.constEnd()) {
+                    continue;
+                }
+                addShifted(completions, next.value(), mine);
+                if (mine == 1) {
+                    QVector<double> ways = convolve(it.value(), next.value());
+                    addShifted(mineWays, ways, 1);
+                }
+            }
+            previous.insert(it.key(), completions);
+        }
+        backward = previous;
+        forward[step + 1].clear();
+    }
+}
+
+// Were all the probabilities counted exactly, with no component estimated?
+bool ProbabilityEngine::isExact() const
+{
+    return m_estimated.isEmpty();
+}
+
+// Probability that an unknown cell contains a mine
+double ProbabilityEngine::mineProbability(int row, int col) const
+{
+    return m_probabilities.value(row * m_cols + col, m_interiorProbability);
+}
+
+// Probability for each unknown cell not next to a revealed count
+double ProbabilityEngine::interiorProbability() const
+{
+    return m_interiorProbability;
+}
+
+// Is this unknown cell next to a revealed count?
+bool ProbabilityEngine::isFrontierCell(int row, int col) const
+{
+    return m_probabilities.contains(row * m_cols + col);
+}
+
+// Find the frontier cell least likely to be a mine, optionally skipping
+// cells whose probability is only an estimate
+bool ProbabilityEngine::safestFrontierCell(int &row, int &col, double &probability,
+                                           bool exactOnly) const
+{
+    int best = -1;
+    probability = 1;
+    for (auto it = m_probabilities.constBegin(); it != m_probabilities.constEnd(); ++it) {
+        if (exactOnly && m_estimated.contains(it.key())) {
+            continue;
+        }
+        if (best < 0 || it.value() < probability) {
+            best = it.key();
+            probability = it.value();
+        }
+    }
+    if (best < 0) {
+        return false;
+    }
+    row = best / m_cols;
+    col = best % m_cols;
+    return true;
+}
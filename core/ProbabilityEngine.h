@@ -0,0 +1,80 @@
+#ifndef PROBABILITYENGINE_H
+#define PROBABILITYENGINE_H
+
+#include "Solver.h"
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+// Exact mine probabilities for the unknown cells of a board
+//
+// Built on the Solver's frontier. The unknown cells next to the
+// frontier are split into independent components: cells are connected
+// when a revealed count constrains both. For each component every
+// consistent placement of mines is counted, grouped by how many mines
+// it uses, with a dynamic program over the component's cells. The
+// components are then combined with the number of mines left for the
+// rest of the board to give each cell's probability of being a mine.
+//
+// Counting is exact as long as a component needs at most MaxStates
+// partial states at any step of the program. A component past that is
+// estimated instead: each of its cells gets the mine density of its
+// densest constraint, and the mines that adds up to are taken off those
+// left for the rest of the board. isExact() tells whether that happened,
+// and safestFrontierCell() can be asked to pass over estimated cells.
+//
+// Large components are solved in parallel on the global thread pool,
+// unless that is turned off because the caller already runs one engine
+// per thread; small ones are solved on the calling thread. Results are
+// cached by component contents, so after a move only the components it
+// changed are solved again.
+
+class ProbabilityEngine
+{
+public:
+    ProbabilityEngine();
+    void clear();
+    void setParallel(bool parallel);
+    void compute(const Solver &solver);
+    bool isExact() const;
+    double mineProbability(int row, int col) const;
+    double interiorProbability() const;
+    bool isFrontierCell(int row, int col) const;
+    bool safestFrontierCell(int &row, int &col, double &probability,
+                            bool exactOnly = false) const;
+
+private:
+    // Solution counts for one component. Cells are in ascending order;
+    // ways[k] counts placements using k mines, and mineWays[i][k] counts
+    // those in which cell i is a mine.
+    struct ComponentResult {
+        QVector<int> cells;
+        QVector<double> ways;
+        QVector<QVector<double>> mineWays;
+        bool exact;
+    };
+
+    // A component waiting to be solved
+    struct Component {
+        QByteArray key;
+        QVector<int> cells;
+        QVector<QVector<int>> constraints;
+        QVector<int> minesLeft;
+        ComponentResult result;
+    };
+
+    static void solveComponent(Component &component);
+    void combine(const QVector<const ComponentResult *> &results, int minesLeft, int numInterior);
+
+private:
+    int m_cols;
+    bool m_parallel;
+    QHash<QByteArray, ComponentResult> m_cache;
+    QHash<int, double> m_probabilities;
+    // Frontier cells whose probability is an estimate, not a count
+    QSet<int> m_estimated;
+    double m_interiorProbability;
+};
+
+#endif // PROBABILITYENGINE_H
@@ -0,0 +1,64 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <QtGlobal>
+
+// Small, fast pseudo-random number generator (xoshiro256**)
+//
+// Each Board owns one of these so that a board can be reproduced
+// exactly from its dimensions, mine count and 64-bit seed.
+
+class Random
+{
+public:
+    explicit Random(quint64 seed = 0) { setSeed(seed); }
+
+    // Expand a 64-bit seed into the full generator state with splitmix64
+    void setSeed(quint64 seed)
+    {
+        for (int i = 0; i < 4; i++) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            quint64 z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            m_state[i] = z ^ (z >> 31);
+        }
+    }
+
+    // Return the next 64 random bits
+    quint64 next()
+    {
+        quint64 result = rotl(m_state[1] * 5, 7) * 9;
+        quint64 t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+    }
+
+    // Return a uniformly distributed number in [0, range)
+    quint64 bounded(quint64 range)
+    {
+        // Reject the few values that would bias the modulo
+        quint64 threshold = (0 - range) % range;
+        quint64 value;
+        do {
+            value = next();
+        } while (value < threshold);
+        return value % range;
+    }
+
+private:
+    static quint64 rotl(quint64 x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+private:
+    quint64 m_state[4];
+};
+
+#endif // RANDOM_H
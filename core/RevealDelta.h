@@ -0,0 +1,22 @@
+#ifndef REVEALDELTA_H
+#define REVEALDELTA_H
+
+#include <QVector>
+#include <QMetaType>
+
+// A cell uncovered by the game, with what it turned out to contain
+struct RevealedCell
+{
+    qint32 row;
+    qint32 col;
+    quint8 count;
+    bool hasMine;
+};
+
+// All of the cells uncovered by a single player action.
+// Sent to the UI in one signal so that it can be applied in one repaint.
+typedef QVector<RevealedCell> RevealDelta;
+
+Q_DECLARE_METATYPE(RevealDelta)
+
+#endif // REVEALDELTA_H
@@ -0,0 +1,416 @@
+#include "Solver.h"
+
+Solver::Solver()
+{
+    m_rows = 0;
+    m_cols = 0;
+    m_mines = 0;
+    m_numKnownMines = 0;
+}
+
+// Forget everything and start solving a new board
+void Solver::reset(int rows, int cols, int mines)
+{
+    m_rows = rows;
+    m_cols = cols;
+    m_mines = mines;
+    m_numKnownMines = 0;
+
+    int numCells = m_rows * m_cols;
+    m_state.fill(Unknown, numCells);
+    m_counts.fill(0, numCells);
+    m_dirty.clear();
+    m_safeCells.clear();
+    m_frontier.clear();
+    m_frontierPos.fill(-1, numCells);
+    m_unknown.resize(numCells);
+    m_unknownPos.resize(numCells);
+    for (int index = 0; index < numCells; index++) {
+        m_unknown[index] = index;
+        m_unknownPos[index] = index;
+    }
+}
+
+// Update the frontier with the cells revealed by a move and
+// deduce whatever follows from them
+void Solver::cellsCleared(const RevealDelta &cells)
+{
+    for (const RevealedCell &cell : cells) {
+        int index = cell.row * m_cols + cell.col;
+        CellState oldState = state(index);
+        if (oldState == Revealed) {
+            continue;
+        }
+        removeUnknown(index);
+
+        if (cell.hasMine) {
+            // Only happens when the game is lost
+            if (oldState != Mine) {
+                setState(index, Mine);
+                m_numKnownMines++;
+                markNeighborsDirty(index);
+            }
+            continue;
+        }
+
+        setState(index, Revealed);
+        m_counts[index] = cell.count;
+        // This cell is a new constraint, and its neighbors lost an unknown
+        markDirty(index);
+        markNeighborsDirty(index);
+    }
+
+    propagate();
+}
+
+// Take new counts for revealed cells, after the board's mines were moved
+// by a generator. Deductions already made must still hold: only mines the
+// solver hasn't worked out may have moved, and not next to a cell that
+// was revealed or deduced safe. Every changed count must be given at
+// once, or the others would be checked against stale ones.
+void Solver::countsChanged(const RevealDelta &cells)
+{
+    for (const RevealedCell &cell : cells) {
+        int index = cell.row * m_cols + cell.col;
+        if (state(index) == Revealed && m_counts[index] != cell.count) {
+            m_counts[index] = cell.count;
+            markDirty(index);
+        }
+    }
+    propagate();
+}
+
+// Return a cell known to be safe that has not been revealed yet
+bool Solver::nextSafeCell(int &row, int &col)
+{
+    while (true) {
+        while (!m_safeCells.isEmpty()) {
+            int index = m_safeCells.takeLast();
+            if (state(index) == Safe) {
+                row = index / m_cols;
+                col = index % m_cols;
+                return true;
+            }
+        }
+        // Local deductions have run out; try the total mine count
+        int numSafe = m_safeCells.size();
+        applyMineTotal();
+        if (m_safeCells.size() == numSafe) {
+            return false;
+        }
+    }
+}
+
+Solver::CellState Solver::cellState(int row, int col) const
+{
+    return state(row * m_cols + col);
+}
+
+// Revealed count of a cell
+int Solver::mineCount(int row, int col) const
+{
+    return m_counts[row * m_cols + col];
+}
+
+// Number of cells known to be mines
+int Solver::numKnownMines() const
+{
+    return m_numKnownMines;
+}
+
+// Number of cells that are neither revealed nor deduced
+int Solver::numUnknownCells() const
+{
+    return m_unknown.size();
+}
+
+// Index of the nth unknown cell, in no particular order
+int Solver::unknownCell(int n) const
+{
+    return m_unknown[n];
+}
+
+// Revealed cells that still have unknown neighbors
+const QVector<int> &Solver::frontier() const
+{
+    return m_frontier;
+}
+
+int Solver::rows() const
+{
+    return m_rows;
+}
+
+int Solver::cols() const
+{
+    return m_cols;
+}
+
+int Solver::mines() const
+{
+    return m_mines;
+}
+
+// Collect the unknown neighbors of a revealed cell, and work out how
+// many mines are among them. Returns the number of unknown neighbors.
+int Solver::unknownNeighbors(int index, int *neighbors, int &minesLeft) const
+{
+    int row = index / m_cols;
+    int col = index % m_cols;
+    int numUnknown = 0;
+    minesLeft = m_counts[index];
+
+    for (int i = qMax(row - 1, 0); i <= qMin(row + 1, m_rows - 1); i++) {
+        for (int j = qMax(col - 1, 0); j <= qMin(col + 1, m_cols - 1); j++) {
+            int neighbor = i * m_cols + j;
+            CellState neighborState = state(neighbor);
+            if (neighborState == Unknown) {
+                neighbors[numUnknown++] = neighbor;
+            } else if (neighborState == Mine) {
+                minesLeft--;
+            }
+        }
+    }
+
+    return numUnknown;
+}
+
+Solver::CellState Solver::state(int index) const
+{
+    return static_cast<CellState>(m_state[index] & StateMask);
+}
+
+void Solver::setState(int index, CellState state)
+{
+    m_state[index] = static_cast<quint8>((m_state[index] & ~StateMask) | state);
+}
+
+// Queue a revealed cell's constraint to be checked
+void Solver::markDirty(int index)
+{
+    if (!(m_state[index] & Queued)) {
+        m_state[index] |= Queued;
+        m_dirty.append(index);
+    }
+}
+
+// Queue the constraints of all revealed cells around a cell
+void Solver::markNeighborsDirty(int index)
+{
+    int row = index / m_cols;
+    int col = index % m_cols;
+    for (int i = qMax(row - 1, 0); i <= qMin(row + 1, m_rows - 1); i++) {
+        for (int j = qMax(col - 1, 0); j <= qMin(col + 1, m_cols - 1); j++) {
+            int neighbor = i * m_cols + j;
+            if (neighbor != index && state(neighbor) == Revealed) {
+                markDirty(neighbor);
+            }
+        }
+    }
+}
+
+// Record that an unknown cell cannot contain a mine
+void Solver::markSafe(int index)
+{
+    if (state(index) != Unknown) {
+        return;
+    }
+    setState(index, Safe);
+    removeUnknown(index);
+    m_safeCells.append(index);
+    markNeighborsDirty(index);
+}
+
+// Record that an unknown cell must contain a mine
+void Solver::markMine(int index)
+{
+    if (state(index) != Unknown) {
+        return;
+    }
+    setState(index, Mine);
+    removeUnknown(index);
+    m_numKnownMines++;
+    markNeighborsDirty(index);
+}
+
+void Solver::addToFrontier(int index)
+{
+    if (m_frontierPos[index] < 0) {
+        m_frontierPos[index] = m_frontier.size();
+        m_frontier.append(index);
+    }
+}
+
+// Remove a cell from the frontier by swapping the last cell into its place
+void Solver::removeFromFrontier(int index)
+{
+    int position = m_frontierPos[index];
+    if (position < 0) {
+        return;
+    }
+    int last = m_frontier.last();
+    m_frontier[position] = last;
+    m_frontierPos[last] = position;
+    m_frontier.removeLast();
+    m_frontierPos[index] = -1;
+}
+
+// Remove a cell from the unknown list by swapping the last cell into its place
+void Solver::removeUnknown(int index)
+{
+    int position = m_unknownPos[index];
+    if (position < 0) {
+        return;
+    }
+    int last = m_unknown.last();
+    m_unknown[position] = last;
+    m_unknownPos[last] = position;
+    m_unknown.removeLast();
+    m_unknownPos[index] = -1;
+}
+
+// Check queued constraints until no more deductions can be made
+void Solver::propagate()
+{
+    while (!m_dirty.isEmpty()) {
+        int index = m_dirty.takeLast();
+        m_state[index] &= ~Queued;
+        if (state(index) == Revealed) {
+            checkConstraint(index);
+        }
+    }
+}
+
+// Check one revealed cell's constraint, on its own and against every
+// revealed cell close enough to share unknown neighbors with it.
+// Returns true if anything was deduced.
+bool Solver::checkConstraint(int index)
+{
+    int cells[8];
+    int minesLeft;
+    int numCells = unknownNeighbors(index, cells, minesLeft);
+    if (numCells == 0) {
+        removeFromFrontier(index);
+        return false;
+    }
+    addToFrontier(index);
+
+    // No mines left: every unknown neighbor is safe
+    if (minesLeft == 0) {
+        for (int i = 0; i < numCells; i++) {
+            markSafe(cells[i]);
+        }
+        return true;
+    }
+    // As many mines as unknown neighbors: they are all mines
+    if (minesLeft == numCells) {
+        for (int i = 0; i < numCells; i++) {
+            markMine(cells[i]);
+        }
+        return true;
+    }
+
+    // Compare with constraints up to two cells away
+    int row = index / m_cols;
+    int col = index % m_cols;
+    for (int i = qMax(row - 2, 0); i <= qMin(row + 2, m_rows - 1); i++) {
+        for (int j = qMax(col - 2, 0); j <= qMin(col + 2, m_cols - 1); j++) {
+            int other = i * m_cols + j;
+            if (other == index || state(other) != Revealed || m_frontierPos[other] < 0) {
+                continue;
+            }
+            int otherCells[8];
+            int otherMinesLeft;
+            int numOtherCells = unknownNeighbors(other, otherCells, otherMinesLeft);
+            if (numOtherCells == 0) {
+                continue;
+            }
+            if (checkPair(cells, numCells, minesLeft, otherCells, numOtherCells, otherMinesLeft)) {
+                markDirty(index);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Compare two constraints. If A needs every one of its cells outside B
+// to be a mine to reach its mine count, then those cells are mines and
+// B's cells outside A are safe (and the same the other way around).
+// Returns true if anything was deduced.
+bool Solver::checkPair(const int *cellsA, int numA, int minesA,
+                       const int *cellsB, int numB, int minesB)
+{
+    int onlyA[8];
+    int onlyB[8];
+    int numOnlyA = 0;
+    int numOnlyB = 0;
+    for (int i = 0; i < numA; i++) {
+        bool shared = false;
+        for (int j = 0; j < numB && !shared; j++) {
+            shared = cellsA[i] == cellsB[j];
+        }
+        if (!shared) {
+            onlyA[numOnlyA++] = cellsA[i];
+        }
+    }
+    for (int j = 0; j < numB; j++) {
+        bool shared = false;
+        for (int i = 0; i < numA && !shared; i++) {
+            shared = cellsA[i] == cellsB[j];
+        }
+        if (!shared) {
+            onlyB[numOnlyB++] = cellsB[j];
+        }
+    }
+    if (numOnlyA + numOnlyB == 0) {
+        return false;
+    }
+
+    const int *mineCells;
+    const int *safeCells;
+    int numMineCells;
+    int numSafeCells;
+    if (minesA - minesB == numOnlyA) {
+        mineCells = onlyA;
+        numMineCells = numOnlyA;
+        safeCells = onlyB;
+        numSafeCells = numOnlyB;
+    } else if (minesB - minesA == numOnlyB) {
+        mineCells = onlyB;
+        numMineCells = numOnlyB;
+        safeCells = onlyA;
+        numSafeCells = numOnlyA;
+    } else {
+        return false;
+    }
+
+    for (int i = 0; i < numMineCells; i++) {
+        markMine(mineCells[i]);
+    }
+    for (int i = 0; i < numSafeCells; i++) {
+        markSafe(safeCells[i]);
+    }
+    return true;
+}
+
+// Use the number of mines left on the whole board: if none are left every
+// unknown cell is safe, and if every unknown cell is needed they are all mines
+void Solver::applyMineTotal()
+{
+    int minesLeft = m_mines - m_numKnownMines;
+    if (m_unknown.isEmpty() || (minesLeft != 0 && minesLeft != m_unknown.size())) {
+        return;
+    }
+
+    QVector<int> unknown = m_unknown;
+    for (int index : unknown) {
+        if (minesLeft == 0) {
+            markSafe(index);
+        } else {
+            markMine(index);
+        }
+    }
+    propagate();
+}
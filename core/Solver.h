@@ -0,0 +1,82 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "RevealDelta.h"
+#include <QVector>
+
+// Deduces safe cells and mines from the revealed part of a board
+//
+// The solver sees only what a player sees: it is fed the cells revealed
+// by each move and keeps the frontier (revealed cells that still touch
+// unknown cells) up to date. Each revealed count is a constraint on its
+// unknown neighbors. Constraints are checked on their own (no mines left,
+// or every unknown neighbor a mine) and in pairs with nearby constraints
+// (the mines in one constraint but not the other force the rest).
+//
+// Only constraints whose neighborhood changed are rechecked, so each
+// reveal costs time proportional to what it changed, not the board size.
+
+class Solver
+{
+public:
+    enum CellState {
+        Unknown,
+        Revealed,
+        Mine,
+        Safe
+    };
+
+    Solver();
+    void reset(int rows, int cols, int mines);
+    void cellsCleared(const RevealDelta &cells);
+    void countsChanged(const RevealDelta &cells);
+    bool nextSafeCell(int &row, int &col);
+    CellState cellState(int row, int col) const;
+    int mineCount(int row, int col) const;
+    int numKnownMines() const;
+    int numUnknownCells() const;
+    int unknownCell(int n) const;
+    const QVector<int> &frontier() const;
+    int rows() const;
+    int cols() const;
+    int mines() const;
+    int unknownNeighbors(int index, int *neighbors, int &minesLeft) const;
+
+private:
+    CellState state(int index) const;
+    void setState(int index, CellState state);
+    void markDirty(int index);
+    void markNeighborsDirty(int index);
+    void markSafe(int index);
+    void markMine(int index);
+    void addToFrontier(int index);
+    void removeFromFrontier(int index);
+    void removeUnknown(int index);
+    void propagate();
+    bool checkConstraint(int index);
+    bool checkPair(const int *cellsA, int numA, int minesA,
+                   const int *cellsB, int numB, int minesB);
+    void applyMineTotal();
+
+private:
+    // Cell state in the low bits, plus a flag for cells waiting to be checked
+    static const quint8 StateMask = 0x03;
+    static const quint8 Queued = 0x04;
+    QVector<quint8> m_state;
+    QVector<quint8> m_counts;
+    // Constraints to recheck, and deduced safe cells not yet revealed
+    QVector<int> m_dirty;
+    QVector<int> m_safeCells;
+    // Revealed cells with unknown neighbors, and each cell's position in that list
+    QVector<int> m_frontier;
+    QVector<int> m_frontierPos;
+    // Unknown cells, and each cell's position in that list
+    QVector<int> m_unknown;
+    QVector<int> m_unknownPos;
+    int m_rows;
+    int m_cols;
+    int m_mines;
+    int m_numKnownMines;
+};
+
+#endif // SOLVER_H
@@ -0,0 +1,68 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <QAtomicInteger>
+#include <QVector>
+#include <utility>
+
+// Bounded lock-free queue for one producer thread and one consumer thread
+//
+// A ring buffer with a head index written only by the consumer and a
+// tail index written only by the producer. Each side publishes its index
+// with release ordering after touching the slot, and reads the other
+// side's index with acquire ordering, so no locks are needed. The two
+// indices sit on separate cache lines so the threads don't contend.
+//
+// push() and pop() never block: they fail when the queue is full or empty.
+
+template <typename T>
+class SpscQueue
+{
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscQueue(int capacity)
+    {
+        int size = 1;
+        while (size < capacity) {
+            size *= 2;
+        }
+        m_slots.resize(size);
+        m_data = m_slots.data();
+        m_mask = static_cast<quint32>(size - 1);
+    }
+
+    // Producer only. Returns false if the queue is full.
+    bool push(const T &value)
+    {
+        quint32 tail = m_tail.loadAcquire();
+        if (tail - m_head.loadAcquire() > m_mask) {
+            return false;
+        }
+        m_data[tail & m_mask] = value;
+        m_tail.storeRelease(tail + 1);
+        return true;
+    }
+
+    // Consumer only. Returns false if the queue is empty.
+    bool pop(T &value)
+    {
+        quint32 head = m_head.loadAcquire();
+        if (head == m_tail.loadAcquire()) {
+            return false;
+        }
+        // Leave an empty value behind so the slot doesn't hold on to memory
+        value = std::move(m_data[head & m_mask]);
+        m_data[head & m_mask] = T();
+        m_head.storeRelease(head + 1);
+        return true;
+    }
+
+private:
+    QVector<T> m_slots;
+    T *m_data;
+    quint32 m_mask;
+    alignas(64) QAtomicInteger<quint32> m_head;
+    alignas(64) QAtomicInteger<quint32> m_tail;
+};
+
+#endif // SPSCQUEUE_H
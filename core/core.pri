@@ -0,0 +1,17 @@
+# Include this file to build against the headless game engine library
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+# The library is static, so its Qt dependencies are linked here
+QT += concurrent
+
+win32:CONFIG(release, debug|release): CORE_LIB_DIR = $$OUT_PWD/../core/release
+else:win32:CONFIG(debug, debug|release): CORE_LIB_DIR = $$OUT_PWD/../core/debug
+else: CORE_LIB_DIR = $$OUT_PWD/../core
+
+LIBS += -L$$CORE_LIB_DIR -lminesweepercore
+
+win32-g++: PRE_TARGETDEPS += $$CORE_LIB_DIR/libminesweepercore.a
+else:win32:!win32-g++: PRE_TARGETDEPS += $$CORE_LIB_DIR/minesweepercore.lib
+else: PRE_TARGETDEPS += $$CORE_LIB_DIR/libminesweepercore.a
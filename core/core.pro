@@ -0,0 +1,52 @@
+#-------------------------------------------------
+#
+# Headless Minesweeper game engine.
+# Depends on Qt Core (and Concurrent) only, so it can be used without a display.
+#
+#-------------------------------------------------
+
+QT       = core concurrent
+
+TARGET = minesweepercore
+TEMPLATE = lib
+CONFIG += staticlib c++11
+
+# The following define makes your compiler emit warnings if you use
+# any feature of Qt which has been marked as deprecated (the exact warnings
+# depend on your compiler). Please consult the documentation of the
+# deprecated API in order to know how to port your code away from it.
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    Board.cpp \
+    ChunkedBoard.cpp \
+    ChunkedGameEngine.cpp \
+    GameEngine.cpp \
+    GameRecord.cpp \
+    GameReplay.cpp \
+    FloodFill.cpp \
+    Solver.cpp \
+    ProbabilityEngine.cpp \
+    NoGuessGenerator.cpp \
+    BoardPool.cpp \
+    EngineThread.cpp
+
+HEADERS += \
+    Board.h \
+    Random.h \
+    RevealDelta.h \
+    GameListener.h \
+    GameEngine.h \
+    GameRecord.h \
+    GameReplay.h \
+    FixedBoard.h \
+    FixedGameEngine.h \
+    ChunkedBoard.h \
+    ChunkedGameEngine.h \
+    FloodFill.h \
+    Solver.h \
+    ProbabilityEngine.h \
+    NoGuessGenerator.h \
+    BoardPool.h \
+    SpscQueue.h \
+    EngineThread.h
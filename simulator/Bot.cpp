@@ -0,0 +1,20 @@
+#include "Bot.h"
+#include "RandomBot.h"
+#include "SolverBot.h"
+
+// Available bots, by name
+Bot *Bot::create(const QString &name)
+{
+    if (name == "random") {
+        return new RandomBot();
+    }
+    if (name == "solver") {
+        return new SolverBot();
+    }
+    return nullptr;
+}
+
+QStringList Bot::names()
+{
+    return QStringList() << "random" << "solver";
+}
@@ -0,0 +1,36 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include "GameListener.h"
+#include <QString>
+#include <QStringList>
+
+// A headless player for the simulator
+//
+// A bot follows the game through the GameListener interface, seeing
+// only what a human player would see, and chooses one move at a time.
+// Each simulator thread owns its own bot, so bots need not be thread safe.
+
+class Bot : public GameListener
+{
+public:
+    struct Move {
+        enum Type {
+            Clear,
+            Flag
+        };
+        Type type;
+        int row;
+        int col;
+    };
+
+    // Create a bot by name, or return nullptr if the name is unknown
+    static Bot *create(const QString &name);
+    static QStringList names();
+
+    virtual void newGame(int rows, int cols, int mines, quint64 seed) = 0;
+    // Choose the next move. Return false to give up on the game.
+    virtual bool nextMove(Move &move) = 0;
+};
+
+#endif // BOT_H
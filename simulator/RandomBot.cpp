@@ -0,0 +1,59 @@
+#include "RandomBot.h"
+
+RandomBot::RandomBot()
+{
+    m_cols = 0;
+}
+
+void RandomBot::newGame(int rows, int cols, int mines, quint64 seed)
+{
+    Q_UNUSED(mines)
+
+    // Use a different stream from the one that placed the mines
+    m_random.setSeed(~seed);
+    m_cols = cols;
+
+    // Every cell starts out covered
+    int numCells = rows * cols;
+    m_covered.resize(numCells);
+    m_position.resize(numCells);
+    for (int index = 0; index < numCells; index++) {
+        m_covered[index] = index;
+        m_position[index] = index;
+    }
+}
+
+// Pick any covered cell
+bool RandomBot::nextMove(Move &move)
+{
+    if (m_covered.isEmpty()) {
+        return false;
+    }
+
+    int index = m_covered[static_cast<int>(m_random.bounded(m_covered.size()))];
+    move.type = Move::Clear;
+    move.row = index / m_cols;
+    move.col = index % m_cols;
+    return true;
+}
+
+void RandomBot::cellsCleared(const RevealDelta &cells)
+{
+    for (const RevealedCell &cell : cells) {
+        removeCovered(cell.row * m_cols + cell.col);
+    }
+}
+
+// Remove a cell from the covered list by swapping the last cell into its place
+void RandomBot::removeCovered(int index)
+{
+    int position = m_position[index];
+    if (position < 0) {
+        return;
+    }
+    int last = m_covered.last();
+    m_covered[position] = last;
+    m_position[last] = position;
+    m_covered.removeLast();
+    m_position[index] = -1;
+}
@@ -0,0 +1,29 @@
+#ifndef RANDOMBOT_H
+#define RANDOMBOT_H
+
+#include "Bot.h"
+#include "Random.h"
+#include <QVector>
+
+// Baseline bot that clears a random covered cell every move
+
+class RandomBot : public Bot
+{
+public:
+    RandomBot();
+    void newGame(int rows, int cols, int mines, quint64 seed) override;
+    bool nextMove(Move &move) override;
+    void cellsCleared(const RevealDelta &cells) override;
+
+private:
+    void removeCovered(int index);
+
+private:
+    Random m_random;
+    int m_cols;
+    // Covered cells, and each cell's position in that list (-1 once cleared)
+    QVector<int> m_covered;
+    QVector<int> m_position;
+};
+
+#endif // RANDOMBOT_H
@@ -0,0 +1,121 @@
+#include "Simulator.h"
+#include "Bot.h"
+#include "FixedGameEngine.h"
+#include "GameEngine.h"
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QScopedPointer>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrent>
+
+namespace {
+
+// Number of games a thread claims at a time
+const qint64 BatchSize = 256;
+
+typedef SimulationResult (*ShardFunction)(const QString &botName, const BoardConfig &config,
+                                          qint64 numGames, quint64 baseSeed,
+                                          QAtomicInteger<qint64> *nextGame);
+
+// Play games until every game in the run has been claimed. Engine is
+// GameEngine, or a FixedGameEngine of the configuration's size.
+template <typename Engine>
+SimulationResult playShard(const QString &botName, const BoardConfig &config,
+                           qint64 numGames, quint64 baseSeed, QAtomicInteger<qint64> *nextGame)
+{
+    SimulationResult result = {};
+
+    QScopedPointer<Bot> bot(Bot::create(botName));
+    Engine engine;
+    engine.setListener(bot.data());
+    // Stop runaway bots that never finish a game
+    int maxMoves = 4 * config.rows * config.cols;
+
+    while (true) {
+        qint64 first = nextGame->fetchAndAddRelaxed(BatchSize);
+        if (first >= numGames) {
+            break;
+        }
+        qint64 last = qMin(first + BatchSize, numGames);
+        for (qint64 game = first; game < last; game++) {
+            quint64 seed = baseSeed + static_cast<quint64>(game);
+            engine.startGame(config.rows, config.cols, config.mines, seed);
+            bot->newGame(config.rows, config.cols, config.mines, seed);
+
+            Bot::Move move;
+            int moves = 0;
+            while (engine.state() == GameEngine::Playing && moves < maxMoves && bot->nextMove(move)) {
+                if (move.type == Bot::Move::Clear) {
+                    engine.cellClicked(move.row, move.col);
+                } else {
+                    engine.cellFlagged(move.row, move.col);
+                }
+                moves++;
+            }
+
+            result.games++;
+            result.moves += moves;
+            if (engine.state() == GameEngine::Won) {
+                result.wins++;
+            }
+        }
+    }
+
+    return result;
+}
+
+// The standard difficulties are played on boards sized at compile time,
+// anything else on runtime-sized boards
+ShardFunction shardFunction(const BoardConfig &config)
+{
+    if (config.rows == 8 && config.cols == 8) {
+        return playShard<FixedGameEngine<8, 8>>;
+    }
+    if (config.rows == 16 && config.cols == 16) {
+        return playShard<FixedGameEngine<16, 16>>;
+    }
+    if (config.rows == 16 && config.cols == 30) {
+        return playShard<FixedGameEngine<16, 30>>;
+    }
+    return playShard<GameEngine>;
+}
+
+}
+
+Simulator::Simulator(const QString &botName, int numThreads)
+{
+    m_botName = botName;
+    m_numThreads = qMax(1, numThreads);
+}
+
+// Play numGames games on one board configuration and total the results
+SimulationResult Simulator::run(const BoardConfig &config, qint64 numGames, quint64 baseSeed)
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(m_numThreads);
+    QAtomicInteger<qint64> nextGame(0);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // One shard per thread; shards pull batches of games until none are left
+    ShardFunction playShard = shardFunction(config);
+    QVector<QFuture<SimulationResult>> shards;
+    for (int thread = 0; thread < m_numThreads; thread++) {
+        shards.append(QtConcurrent::run(&pool, playShard, m_botName, config,
+                                        numGames, baseSeed, &nextGame));
+    }
+
+    SimulationResult total = {};
+    for (QFuture<SimulationResult> &shard : shards) {
+        SimulationResult result = shard.result();
+        total.games += result.games;
+        total.wins += result.wins;
+        total.moves += result.moves;
+    }
+    total.seconds = timer.elapsed() / 1000.0;
+
+    return total;
+}
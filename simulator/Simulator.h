@@ -0,0 +1,41 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <QString>
+
+// Board size and mine count to simulate
+struct BoardConfig
+{
+    QString name;
+    int rows;
+    int cols;
+    int mines;
+};
+
+// Totals from simulating many games on one board configuration
+struct SimulationResult
+{
+    qint64 games;
+    qint64 wins;
+    qint64 moves;
+    double seconds;
+};
+
+// Plays many headless games with a bot, spread across threads
+//
+// Game n of a run is played on the board generated from seed
+// baseSeed + n, so results are reproducible whatever the number of
+// threads. Threads claim games in batches and share nothing else.
+
+class Simulator
+{
+public:
+    Simulator(const QString &botName, int numThreads);
+    SimulationResult run(const BoardConfig &config, qint64 numGames, quint64 baseSeed);
+
+private:
+    QString m_botName;
+    int m_numThreads;
+};
+
+#endif // SIMULATOR_H
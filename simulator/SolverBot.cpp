@@ -0,0 +1,80 @@
+#include "SolverBot.h"
+
+namespace {
+
+// Random picks to try when looking for an interior cell
+const int MaxInteriorTries = 64;
+
+}
+
+SolverBot::SolverBot()
+{
+    // The simulator already runs a bot on each of its threads
+    m_probabilities.setParallel(false);
+}
+
+void SolverBot::newGame(int rows, int cols, int mines, quint64 seed)
+{
+    // Use a different stream from the one that placed the mines
+    m_random.setSeed(~seed);
+    m_solver.reset(rows, cols, mines);
+    m_probabilities.clear();
+}
+
+bool SolverBot::nextMove(Move &move)
+{
+    move.type = Move::Clear;
+    if (m_solver.nextSafeCell(move.row, move.col)) {
+        return true;
+    }
+
+    // Nothing is provably safe, so guess the safest cell
+    if (m_solver.numUnknownCells() == 0) {
+        return false;
+    }
+    // Estimated probabilities, for components too large to count, are
+    // only a rough guide, so counted ones and the interior come first
+    m_probabilities.compute(m_solver);
+    double probability;
+    bool haveFrontierCell = m_probabilities.safestFrontierCell(move.row, move.col, probability, true);
+    if (haveFrontierCell && probability <= m_probabilities.interiorProbability()) {
+        return true;
+    }
+    if (randomInteriorCell(move.row, move.col)) {
+        return true;
+    }
+    if (haveFrontierCell) {
+        return true;
+    }
+    return !m_probabilities.isExact()
+            && m_probabilities.safestFrontierCell(move.row, move.col, probability);
+}
+
+void SolverBot::cellsCleared(const RevealDelta &cells)
+{
+    m_solver.cellsCleared(cells);
+}
+
+// Pick a random unknown cell that is not next to any revealed count
+bool SolverBot::randomInteriorCell(int &row, int &col)
+{
+    int numUnknown = m_solver.numUnknownCells();
+    for (int i = 0; i < MaxInteriorTries; i++) {
+        int index = m_solver.unknownCell(static_cast<int>(m_random.bounded(numUnknown)));
+        row = index / m_solver.cols();
+        col = index % m_solver.cols();
+        if (!m_probabilities.isFrontierCell(row, col)) {
+            return true;
+        }
+    }
+    // Mostly frontier; search in order instead
+    for (int n = 0; n < numUnknown; n++) {
+        int index = m_solver.unknownCell(n);
+        row = index / m_solver.cols();
+        col = index % m_solver.cols();
+        if (!m_probabilities.isFrontierCell(row, col)) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,29 @@
+#ifndef SOLVERBOT_H
+#define SOLVERBOT_H
+
+#include "Bot.h"
+#include "ProbabilityEngine.h"
+#include "Random.h"
+#include "Solver.h"
+
+// Bot that clears every cell the solver can prove is safe,
+// and guesses the cell least likely to be a mine when it can't prove anything
+
+class SolverBot : public Bot
+{
+public:
+    SolverBot();
+    void newGame(int rows, int cols, int mines, quint64 seed) override;
+    bool nextMove(Move &move) override;
+    void cellsCleared(const RevealDelta &cells) override;
+
+private:
+    bool randomInteriorCell(int &row, int &col);
+
+private:
+    Solver m_solver;
+    ProbabilityEngine m_probabilities;
+    Random m_random;
+};
+
+#endif // SOLVERBOT_H
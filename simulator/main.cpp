@@ -0,0 +1,117 @@
+#include "Simulator.h"
+#include "Bot.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QStringList>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+
+namespace {
+
+// Parse a board configuration: a difficulty name or ROWSxCOLSxMINES
+bool parseConfig(const QString &text, BoardConfig &config)
+{
+    if (text == "easy") {
+        config = { text, 8, 8, 10 };
+        return true;
+    }
+    if (text == "medium") {
+        config = { text, 16, 16, 40 };
+        return true;
+    }
+    if (text == "hard") {
+        config = { text, 16, 30, 99 };
+        return true;
+    }
+
+    QStringList parts = text.split('x');
+    if (parts.size() != 3) {
+        return false;
+    }
+    bool rowsOk, colsOk, minesOk;
+    config.name = text;
+    config.rows = parts[0].toInt(&rowsOk);
+    config.cols = parts[1].toInt(&colsOk);
+    config.mines = parts[2].toInt(&minesOk);
+    return rowsOk && colsOk && minesOk && config.rows > 0 && config.cols > 0
+            && config.mines >= 0 && config.mines < config.rows * config.cols;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("minesweeper-sim");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Plays Minesweeper games headlessly with a bot "
+                                     "and reports throughput and win rates.");
+    parser.addHelpOption();
+    QCommandLineOption gamesOption(QStringList() << "n" << "games",
+                                   "Number of games per board configuration.", "count", "100000");
+    QCommandLineOption threadsOption(QStringList() << "j" << "threads",
+                                     "Number of worker threads.", "count",
+                                     QString::number(QThread::idealThreadCount()));
+    QCommandLineOption botOption(QStringList() << "b" << "bot",
+                                 "Bot to play with: " + Bot::names().join(", ") + ".", "name", "random");
+    QCommandLineOption seedOption(QStringList() << "s" << "seed",
+                                  "Seed of the first game; game n uses seed + n.", "seed", "1");
+    parser.addOption(gamesOption);
+    parser.addOption(threadsOption);
+    parser.addOption(botOption);
+    parser.addOption(seedOption);
+    parser.addPositionalArgument("configs", "Board configurations: easy, medium, hard or "
+                                            "ROWSxCOLSxMINES. Defaults to all three difficulties.",
+                                 "[configs...]");
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    // Check arguments
+    QString botName = parser.value(botOption);
+    if (!Bot::names().contains(botName)) {
+        err << "Unknown bot: " << botName << "\n";
+        return 1;
+    }
+    qint64 numGames = parser.value(gamesOption).toLongLong();
+    int numThreads = parser.value(threadsOption).toInt();
+    quint64 seed = parser.value(seedOption).toULongLong();
+    if (numGames <= 0 || numThreads <= 0) {
+        err << "Number of games and threads must be positive\n";
+        return 1;
+    }
+
+    QStringList configNames = parser.positionalArguments();
+    if (configNames.isEmpty()) {
+        configNames << "easy" << "medium" << "hard";
+    }
+    QVector<BoardConfig> configs;
+    for (const QString &name : configNames) {
+        BoardConfig config;
+        if (!parseConfig(name, config)) {
+            err << "Invalid board configuration: " << name << "\n";
+            return 1;
+        }
+        configs.append(config);
+    }
+
+    // Run each configuration and report the results
+    out << "bot " << botName << ", " << numThreads << " threads, "
+        << numGames << " games per configuration\n";
+    Simulator simulator(botName, numThreads);
+    for (const BoardConfig &config : configs) {
+        SimulationResult result = simulator.run(config, numGames, seed);
+        double winRate = 100.0 * result.wins / result.games;
+        double gamesPerSecond = result.seconds > 0 ? result.games / result.seconds : 0;
+        out << QString("%1 (%2x%3, %4 mines): %5 games, %6 wins (%7%), %8 games/sec\n")
+               .arg(config.name).arg(config.rows).arg(config.cols).arg(config.mines)
+               .arg(result.games).arg(result.wins)
+               .arg(winRate, 0, 'f', 2).arg(gamesPerSecond, 0, 'f', 0);
+        out.flush();
+    }
+
+    return 0;
+}
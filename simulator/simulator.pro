@@ -0,0 +1,31 @@
+#-------------------------------------------------
+#
+# Command-line Minesweeper simulator.
+# Plays games headlessly with a bot across all cores.
+#
+#-------------------------------------------------
+
+QT       = core concurrent
+
+TARGET = minesweeper-sim
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# Headless game engine
+include(../core/core.pri)
+
+SOURCES += \
+    main.cpp \
+    Simulator.cpp \
+    Bot.cpp \
+    RandomBot.cpp \
+    SolverBot.cpp
+
+HEADERS += \
+    Simulator.h \
+    Bot.h \
+    RandomBot.h \
+    SolverBot.h